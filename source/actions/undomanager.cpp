@@ -17,6 +17,7 @@
 
 #include "undomanager.h"
 
+#include <algorithm>
 #include <memory>
 
 UndoManager::UndoManager(QObject *parent) :
@@ -28,6 +29,12 @@ void UndoManager::addNewUndoStack()
 {
     myUndoStacks.emplace_back(std::make_unique<QUndoStack>());
     addStack(myUndoStacks.back().get());
+
+    // Nothing from a new stack has been seen yet, so treat every system as
+    // modified.
+    auto log = std::make_unique<ChangeLog>();
+    log->myAllSystemsRevision = ++myRevision;
+    myChangeLogs.push_back(std::move(log));
 }
 
 void UndoManager::setActiveStackIndex(int index)
@@ -42,6 +49,7 @@ void UndoManager::removeStack(int index)
 {
     // Stack is automatically removed from the QUndoGroup when it is deleted.
     myUndoStacks.erase(myUndoStacks.begin() + index);
+    myChangeLogs.erase(myChangeLogs.begin() + index);
 }
 
 void UndoManager::push(QUndoCommand *cmd)
@@ -51,36 +59,28 @@ void UndoManager::push(QUndoCommand *cmd)
 
 void UndoManager::push(QUndoCommand *cmd, int affectedSystem)
 {
+    // The commands are deleted along with the active stack, so its change log
+    // outlives the connections below.
+    const int stackIndex = static_cast<int>(
+        std::find_if(myUndoStacks.begin(), myUndoStacks.end(),
+                     [&](auto &stack) { return stack.get() == activeStack(); }) -
+        myUndoStacks.begin());
+    ChangeLog *log = myChangeLogs.at(stackIndex).get();
+
     beginMacro(cmd->actionText());
 
     auto onUndo = new SignalOnUndo();
-    if (affectedSystem >= 0)
-    {
-        connect(onUndo, &SignalOnUndo::triggered, [=, this]() {
-            onSystemChanged(affectedSystem);
-        });
-    }
-    else
-    {
-        connect(onUndo, &SignalOnUndo::triggered, this,
-                &UndoManager::fullRedrawNeeded);
-    }
+    connect(onUndo, &SignalOnUndo::triggered, [=, this]() {
+        onSystemChanged(*log, affectedSystem);
+    });
 
     push(onUndo);
     push(cmd);
 
     auto onRedo = new SignalOnRedo();
-    if (affectedSystem >= 0)
-    {
-        connect(onRedo, &SignalOnRedo::triggered, [=, this]() {
-            onSystemChanged(affectedSystem);
-        });
-    }
-    else
-    {
-        connect(onRedo, &SignalOnRedo::triggered, this,
-                &UndoManager::fullRedrawNeeded);
-    }
+    connect(onRedo, &SignalOnRedo::triggered, [=, this]() {
+        onSystemChanged(*log, affectedSystem);
+    });
 
     push(onRedo);
     endMacro();
@@ -91,9 +91,44 @@ void UndoManager::setClean()
     activeStack()->setClean();
 }
 
-void UndoManager::onSystemChanged(int affectedSystem)
+int UndoManager::getRevision() const
 {
-    emit redrawNeeded(affectedSystem);
+    return myRevision;
+}
+
+std::optional<std::vector<int>> UndoManager::getChangedSystems(
+    int stackIndex, int revision) const
+{
+    const ChangeLog &log = *myChangeLogs.at(stackIndex);
+    if (log.myAllSystemsRevision > revision)
+        return std::nullopt;
+
+    std::vector<int> systems;
+    for (auto &&[system, systemRevision] : log.mySystemRevisions)
+    {
+        if (systemRevision > revision)
+            systems.push_back(system);
+    }
+
+    return systems;
+}
+
+void UndoManager::onSystemChanged(ChangeLog &log, int affectedSystem)
+{
+    ++myRevision;
+
+    if (affectedSystem >= 0)
+    {
+        log.mySystemRevisions[affectedSystem] = myRevision;
+        emit redrawNeeded(affectedSystem);
+    }
+    else
+    {
+        // The system indices may no longer be valid.
+        log.myAllSystemsRevision = myRevision;
+        log.mySystemRevisions.clear();
+        emit fullRedrawNeeded();
+    }
 }
 
 void UndoManager::beginMacro(const QString &text)
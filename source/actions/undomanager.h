@@ -18,7 +18,9 @@
 #ifndef ACTIONS_UNDOMANAGER_H
 #define ACTIONS_UNDOMANAGER_H
 
+#include <map>
 #include <memory>
+#include <optional>
 #include <QUndoGroup>
 #include <QUndoStack>
 #include <vector>
@@ -48,18 +50,39 @@ public:
 
     static const int AFFECTS_ALL_SYSTEMS = -1;
 
+    /// Returns the current revision, which increases each time a command in
+    /// any stack is done or undone.
+    int getRevision() const;
+
+    /// Returns the indices of the systems that have been modified in the
+    /// specified stack since the given revision, or std::nullopt if any of the
+    /// systems might have been modified (e.g. a system was inserted).
+    std::optional<std::vector<int>> getChangedSystems(int stackIndex,
+                                                      int revision) const;
+
 signals:
     void fullRedrawNeeded();
     void redrawNeeded(int);
 
 private:
+    /// Records the revision at which each system in a stack was last modified.
+    struct ChangeLog
+    {
+        /// The last revision at which all of the systems might have changed.
+        int myAllSystemsRevision = 0;
+        std::map<int, int> mySystemRevisions;
+    };
+
     /// Pushes the QUndoCommand onto the active stack.
     void push(QUndoCommand *cmd);
 
-    void onSystemChanged(int affectedSystem);
+    void onSystemChanged(ChangeLog &log, int affectedSystem);
 
     /// QUndoGroup does not own the undo stacks, so we maintain a separate list with ownership.
     std::vector<std::unique_ptr<QUndoStack>> myUndoStacks;
+    /// The change log for each undo stack.
+    std::vector<std::unique_ptr<ChangeLog>> myChangeLogs;
+    int myRevision = 0;
 };
 
 class SignalOnRedo : public QObject, public QUndoCommand
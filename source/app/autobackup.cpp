@@ -17,56 +17,179 @@
 
 #include "autobackup.h"
 
+#include "backupjournal.h"
 #include "documentmanager.h"
 #include "paths.h"
 #include "settings.h"
 #include "settingsmanager.h"
 
 #include <actions/undomanager.h>
-#include <formats/powertab/powertabexporter.h>
 
+#include <QCoreApplication>
+#include <QLockFile>
 #include <QTimer>
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <condition_variable>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <mutex>
-#include <thread>
+#include <optional>
+#include <thread>
 
 namespace
 {
 struct BackupItem
 {
-    /// Saves the file to the backup folder.
-    void save() const;
+    /// Merges in an older backup of the same file that has not been saved yet.
+    void merge(const BackupItem &older);
 
     Score myScore;
     std::filesystem::path myOrigPath;
+    /// The systems that were modified since the previous backup, or
+    /// std::nullopt if the entire score must be saved.
+    std::optional<std::vector<int>> myChangedSystems;
 };
 
 void
-BackupItem::save() const
+BackupItem::merge(const BackupItem &older)
 {
-    PowerTabExporter exporter;
+    if (!myChangedSystems || !older.myChangedSystems)
+    {
+        myChangedSystems.reset();
+        return;
+    }
 
-    auto backup_dir = Paths::getBackupDir();
-    std::filesystem::create_directories(backup_dir);
+    std::vector<int> systems;
+    std::ranges::set_union(*myChangedSystems, *older.myChangedSystems,
+                           std::back_inserter(systems));
+    myChangedSystems = std::move(systems);
+}
 
-    auto filename = myOrigPath.filename();
-    filename.replace_extension(".pt2");
-    
-    auto path = backup_dir / filename;    
+/// Returns the path to the lock file that is held while the instance with the
+/// given process id is running.
+std::filesystem::path
+getSessionLockPath(qint64 pid)
+{
+    return Paths::getBackupDir() / ("session-" + std::to_string(pid) + ".lock");
+}
+
+/// Returns the path to the backup journal for the file. This includes the
+/// process id, so that several instances of the application can back up
+/// the same file (e.g. "song.0123456789abcdef.1234.pt2j").
+std::filesystem::path
+getJournalPath(const std::filesystem::path &orig_path)
+{
+    auto filename = BackupJournal::getName(orig_path);
+    filename += "." + std::to_string(QCoreApplication::applicationPid()) +
+                BackupJournal::FILE_EXTENSION;
+    return Paths::getBackupDir() / filename;
+}
+
+/// Parses the process id from an extension such as ".1234".
+std::optional<qint64>
+parseProcessId(const std::string &extension)
+{
+    if (extension.size() < 2)
+        return std::nullopt;
+
+    qint64 pid = 0;
+    const char *first = extension.data() + 1;
+    const char *last = extension.data() + extension.size();
+    auto [ptr, ec] = std::from_chars(first, last, pid);
+    if (ec != std::errc() || ptr != last)
+        return std::nullopt;
+
+    return pid;
+}
+
+/// Saves the item to its journal, either by appending the modified systems
+/// or by compacting the journal into a new snapshot.
+void
+saveBackup(const BackupItem &item,
+           std::map<std::filesystem::path, BackupJournal> &journals)
+{
+    const auto path = getJournalPath(item.myOrigPath);
+    BackupJournal &journal = journals.try_emplace(path, path).first->second;
 
     try
     {
-        exporter.save(path, myScore);
-        std::cerr << "Saved backup to: " << path << std::endl;
+        if (!item.myChangedSystems || !journal.hasSnapshot() ||
+            journal.needsCompaction())
+        {
+            journal.saveSnapshot(item.myScore);
+            std::cerr << "Saved backup to: " << path << std::endl;
+        }
+        else
+        {
+            journal.saveChanges(item.myScore, *item.myChangedSystems);
+            std::cerr << "Saved " << item.myChangedSystems->size()
+                      << " modified systems to backup: " << path << std::endl;
+        }
     }
     catch (const std::exception &e)
     {
         std::cerr << "Failed to save backup file: " << path << std::endl;
         std::cerr << "Error: " << e.what() << std::endl;
+
+        // The journal may be incomplete, so start over with a new snapshot.
+        journals.erase(path);
+    }
+}
+
+/// Converts any journals from a previous session (e.g. if the application
+/// crashed) into regular backup files that can be opened by the user.
+/// Journals that belong to another instance which is still running are left
+/// alone.
+void
+recoverBackups()
+{
+    const qint64 current_pid = QCoreApplication::applicationPid();
+
+    std::error_code ec;
+    for (auto &&entry :
+         std::filesystem::directory_iterator(Paths::getBackupDir(), ec))
+    {
+        const std::filesystem::path &path = entry.path();
+        if (path.extension() != BackupJournal::FILE_EXTENSION)
+            continue;
+
+        // Journals without a process id are from older versions, and are
+        // always recovered.
+        std::filesystem::path name = path.stem();
+        std::optional<QLockFile> owner_lock;
+        if (auto pid = parseProcessId(name.extension().string()))
+        {
+            name = name.stem();
+
+            // If the owner's lock can be taken, it is no longer running. A
+            // journal with our own process id must be left over from an
+            // earlier process, since nothing has been backed up yet.
+            if (*pid != current_pid)
+            {
+                owner_lock.emplace(Paths::toQString(getSessionLockPath(*pid)));
+                owner_lock->setStaleLockTime(0);
+                if (!owner_lock->tryLock())
+                    continue;
+            }
+        }
+
+        auto backup_path = path.parent_path() / name;
+        backup_path += ".pt2b";
+
+        try
+        {
+            BackupJournal::recover(path, backup_path);
+            std::cerr << "Recovered backup to: " << backup_path << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to recover backup file: " << path << std::endl;
+            std::cerr << "Error: " << e.what() << std::endl;
+        }
     }
 }
 } // namespace
@@ -80,6 +203,26 @@ static bool theFinishedFlag = false;
 static void
 backupThread()
 {
+    std::filesystem::create_directories(Paths::getBackupDir());
+
+    // Hold a lock while this instance is running, so that other instances
+    // don't recover the journals that are still in use. Since the lock file
+    // is named after our process id, an existing lock file can only be left
+    // over from an earlier process.
+    QLockFile session_lock(Paths::toQString(
+        getSessionLockPath(QCoreApplication::applicationPid())));
+    session_lock.setStaleLockTime(0);
+    if (!session_lock.tryLock())
+    {
+        session_lock.removeStaleLockFile();
+        session_lock.tryLock();
+    }
+
+    recoverBackups();
+
+    // The journal for each file that has been backed up in this session.
+    std::map<std::filesystem::path, BackupJournal> journals;
+
     while (true)
     {
         std::vector<BackupItem> backup_items;
@@ -94,10 +237,13 @@ backupThread()
 
             // Move to a local copy so we can release the lock before saving to disk.
             backup_items = std::move(theBackupItems);
+            theBackupItems.clear();
         }
 
+        std::filesystem::create_directories(Paths::getBackupDir());
+
         for (const BackupItem &item : backup_items)
-            item.save();
+            saveBackup(item, journals);
     }
 }
 
@@ -146,11 +292,13 @@ AutoBackup::startBackup()
     auto start = std::chrono::high_resolution_clock::now();
 
     std::vector<BackupItem> items_to_backup;
+    const int revision = myUndoManager.getRevision();
 
     for (int i = 0, n = myDocumentManager.getNumDocuments(); i < n; ++i)
     {
         // Only consider files with unsaved changes.
-        if (myUndoManager.stacks()[i]->isClean())
+        const QUndoStack *undo_stack = myUndoManager.stacks()[i];
+        if (undo_stack->isClean())
             continue;
         
         const Document &doc = myDocumentManager.getDocument(i);
@@ -165,6 +313,31 @@ AutoBackup::startBackup()
         else
             item.myOrigPath = "Untitled_" + std::to_string(i);
 
+        // Find the systems that were modified since the last backup of this
+        // file, if it was from the same document.
+        auto it = myBackupRevisions.find(item.myOrigPath);
+        if (it != myBackupRevisions.end() &&
+            it->second.myUndoStack == undo_stack)
+        {
+            item.myChangedSystems =
+                myUndoManager.getChangedSystems(i, it->second.myRevision);
+
+            // Changes from the mixer don't go through the undo stack, so
+            // also check whether the players were modified. Those are saved
+            // with every set of changes, even if no systems were modified.
+            if (item.myChangedSystems && item.myChangedSystems->empty() &&
+                std::ranges::equal(item.myScore.getPlayers(),
+                                   it->second.myPlayers))
+            {
+                continue;
+            }
+        }
+
+        const auto players = item.myScore.getPlayers();
+        myBackupRevisions[item.myOrigPath] = {
+            undo_stack, revision, { players.begin(), players.end() }
+        };
+
         std::cerr << "Added to backup: " << item.myOrigPath << std::endl;
         
         items_to_backup.push_back(std::move(item));
@@ -176,10 +349,22 @@ AutoBackup::startBackup()
         return;
     }
 
-    // Send the documents to the worker thread to be saved to disk.
+    // Send the documents to the worker thread to be saved to disk. If the
+    // previous backup of a file hasn't been saved yet, replace it.
     {
         std::unique_lock lock(theLock);
-        theBackupItems = std::move(items_to_backup);
+        for (BackupItem &item : items_to_backup)
+        {
+            auto it = std::ranges::find(theBackupItems, item.myOrigPath,
+                                        &BackupItem::myOrigPath);
+            if (it != theBackupItems.end())
+            {
+                item.merge(*it);
+                *it = std::move(item);
+            }
+            else
+                theBackupItems.push_back(std::move(item));
+        }
     }
     theCV.notify_one();
     
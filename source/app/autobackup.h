@@ -20,14 +20,24 @@
 
 #include <QObject>
 #include <boost/signals2/signal.hpp>
+#include <score/player.h>
+#include <filesystem>
+#include <map>
 #include <memory>
 #include <thread>
+#include <vector>
 
 class DocumentManager;
 class QTimer;
+class QUndoStack;
 class SettingsManager;
 class UndoManager;
 
+/// Periodically saves a backup of each document with unsaved changes.
+/// Backups are saved to a journal, so that only the systems which were
+/// modified since the previous backup need to be written. Any journals that
+/// remain from a previous session are converted to regular backup files at
+/// startup.
 class AutoBackup : public QObject
 {
 public:
@@ -43,6 +53,17 @@ private:
     const DocumentManager &myDocumentManager;
     const UndoManager &myUndoManager;
 
+    /// The undo stack revision of the most recent backup for each file.
+    struct BackupRevision
+    {
+        const QUndoStack *myUndoStack = nullptr;
+        int myRevision = 0;
+        /// The players at the time of the backup, since e.g. volume changes
+        /// from the mixer are not recorded by the undo stack.
+        std::vector<Player> myPlayers;
+    };
+    std::map<std::filesystem::path, BackupRevision> myBackupRevisions;
+
     std::unique_ptr<QTimer> myTimer;
     std::thread myWorkerThread;
     boost::signals2::scoped_connection mySettingsListener;
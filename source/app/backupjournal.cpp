@@ -0,0 +1,325 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "backupjournal.h"
+
+#include <fstream>
+#include <iomanip>
+#include <score/binaryserialization.h>
+#include <score/score.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// Identifies a journal at the start of the file.
+static constexpr std::string_view theMagic = "PT2J";
+
+/// The type of each record in the journal.
+enum class RecordType : char
+{
+    Snapshot = 'S',
+    Changes = 'C'
+};
+
+namespace
+{
+/// The modified systems, along with the rest of the score apart from its
+/// systems.
+struct Changes
+{
+    template <class Archive>
+    void serialize(Archive &ar, const FileVersion /*version*/)
+    {
+        ar("system_count", mySystemCount);
+        ar("system_indices", mySystemIndices);
+        ar("systems", mySystems);
+        ar("score_info", myScoreInfo);
+        ar("players", myPlayers);
+        ar("instruments", myInstruments);
+        ar("chord_diagrams", myChordDiagrams);
+        ar("line_spacing", myLineSpacing);
+        ar("view_filters", myViewFilters);
+    }
+
+    void apply(Score &score) const;
+
+    int mySystemCount = 0;
+    std::vector<int> mySystemIndices;
+    std::vector<System> mySystems;
+    ScoreInfo myScoreInfo;
+    std::vector<Player> myPlayers;
+    std::vector<Instrument> myInstruments;
+    std::vector<ChordDiagram> myChordDiagrams;
+    int myLineSpacing = 0;
+    std::vector<ViewFilter> myViewFilters;
+};
+
+void
+Changes::apply(Score &score) const
+{
+    // The system count can only change along with every system, in which case
+    // a snapshot is saved instead.
+    const int system_count = static_cast<int>(score.getSystems().size());
+    if (system_count != mySystemCount ||
+        mySystemIndices.size() != mySystems.size())
+    {
+        throw std::runtime_error("Journal does not match the snapshot");
+    }
+
+    for (size_t i = 0; i < mySystems.size(); ++i)
+    {
+        const int index = mySystemIndices[i];
+        if (index < 0 || index >= system_count)
+            throw std::runtime_error("Invalid system index in journal");
+
+        score.getSystems()[index] = mySystems[i];
+    }
+
+    score.setScoreInfo(myScoreInfo);
+    score.setLineSpacing(myLineSpacing);
+
+    while (!score.getPlayers().empty())
+        score.removePlayer(0);
+    for (const Player &player : myPlayers)
+        score.insertPlayer(player);
+
+    while (!score.getInstruments().empty())
+        score.removeInstrument(0);
+    for (const Instrument &instrument : myInstruments)
+        score.insertInstrument(instrument);
+
+    while (!score.getChordDiagrams().empty())
+        score.removeChordDiagram(0);
+    for (const ChordDiagram &diagram : myChordDiagrams)
+        score.insertChordDiagram(diagram);
+
+    while (!score.getViewFilters().empty())
+        score.removeViewFilter(0);
+    for (const ViewFilter &filter : myViewFilters)
+        score.insertViewFilter(filter);
+}
+} // namespace
+
+/// Writes a record with the given type and contents, and returns the number
+/// of bytes written.
+template <typename T>
+static std::uintmax_t
+writeRecord(std::ostream &output, RecordType type, const T &obj)
+{
+    std::ostringstream data;
+    ScoreUtils::saveBinary(data, obj);
+    const std::string contents = data.str();
+
+    const uint32_t length = static_cast<uint32_t>(contents.size());
+    char header[5] = { static_cast<char>(type) };
+    for (int i = 0; i < 4; ++i)
+        header[i + 1] = static_cast<char>(length >> (8 * i));
+
+    output.write(header, sizeof(header));
+    output.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    output.flush();
+
+    if (!output)
+        throw std::runtime_error("Failed to write backup journal");
+
+    return sizeof(header) + contents.size();
+}
+
+BackupJournal::BackupJournal(const std::filesystem::path &path) : myPath(path)
+{
+}
+
+const std::filesystem::path &
+BackupJournal::getPath() const
+{
+    return myPath;
+}
+
+void
+BackupJournal::saveSnapshot(const Score &score)
+{
+    auto temp_path = myPath;
+    temp_path += ".tmp";
+
+    {
+        std::ofstream output(temp_path, std::ios::out | std::ios::binary |
+                                            std::ios::trunc);
+        output.write(theMagic.data(), theMagic.size());
+        mySnapshotSize = theMagic.size() +
+                         writeRecord(output, RecordType::Snapshot, score);
+    }
+
+    std::filesystem::rename(temp_path, myPath);
+    myChangesSize = 0;
+}
+
+void
+BackupJournal::saveChanges(const Score &score, std::span<const int> systems)
+{
+    if (!hasSnapshot())
+        throw std::logic_error("A snapshot must be saved before any changes");
+
+    // If the file was removed or modified by someone else (e.g. recovered by
+    // another instance of the application), appending to it would produce an
+    // invalid journal, so start over with a new snapshot.
+    std::error_code ec;
+    const std::uintmax_t file_size = std::filesystem::file_size(myPath, ec);
+    if (ec || file_size != mySnapshotSize + myChangesSize)
+    {
+        saveSnapshot(score);
+        return;
+    }
+
+    Changes changes;
+    changes.mySystemCount = static_cast<int>(score.getSystems().size());
+    changes.mySystemIndices.assign(systems.begin(), systems.end());
+    for (int index : systems)
+        changes.mySystems.push_back(score.getSystems()[index]);
+
+    changes.myScoreInfo = score.getScoreInfo();
+    changes.myPlayers.assign(score.getPlayers().begin(),
+                             score.getPlayers().end());
+    changes.myInstruments.assign(score.getInstruments().begin(),
+                                 score.getInstruments().end());
+    changes.myChordDiagrams.assign(score.getChordDiagrams().begin(),
+                                   score.getChordDiagrams().end());
+    changes.myLineSpacing = score.getLineSpacing();
+    changes.myViewFilters.assign(score.getViewFilters().begin(),
+                                 score.getViewFilters().end());
+
+    std::ofstream output(myPath,
+                         std::ios::out | std::ios::binary | std::ios::app);
+    myChangesSize += writeRecord(output, RecordType::Changes, changes);
+}
+
+std::filesystem::path
+BackupJournal::getName(const std::filesystem::path &orig_path)
+{
+    std::ostringstream name;
+    name << orig_path.stem().string() << '.' << std::hex << std::setw(16)
+         << std::setfill('0')
+         << static_cast<uint64_t>(std::filesystem::hash_value(orig_path));
+    return name.str();
+}
+
+bool
+BackupJournal::hasSnapshot() const
+{
+    return mySnapshotSize != 0;
+}
+
+bool
+BackupJournal::needsCompaction() const
+{
+    return myChangesSize > mySnapshotSize;
+}
+
+void
+BackupJournal::load(const std::filesystem::path &path, Score &score)
+{
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    if (!input)
+        throw std::runtime_error("Could not open backup journal");
+
+    std::string magic(theMagic.size(), '\0');
+    if (!input.read(magic.data(), magic.size()) || magic != theMagic)
+        throw std::runtime_error("Not a backup journal");
+
+    const std::uintmax_t file_size = std::filesystem::file_size(path);
+
+    bool has_snapshot = false;
+    std::string contents;
+    while (true)
+    {
+        char header[5];
+        if (!input.read(header, sizeof(header)))
+            break;
+
+        uint32_t length = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            length |= static_cast<uint32_t>(static_cast<uint8_t>(header[i + 1]))
+                      << (8 * i);
+        }
+
+        // Ignore a record that was only partially written. The length might
+        // also be corrupt, so check it before allocating the record.
+        const auto offset = static_cast<std::uintmax_t>(input.tellg());
+        if (length > file_size - offset)
+            break;
+
+        contents.resize(length);
+        if (!input.read(contents.data(), length))
+            break;
+
+        std::istringstream data(contents);
+        switch (static_cast<RecordType>(header[0]))
+        {
+            case RecordType::Snapshot:
+                score = Score();
+                ScoreUtils::loadBinary(data, score);
+                has_snapshot = true;
+                break;
+
+            case RecordType::Changes:
+            {
+                if (!has_snapshot)
+                    throw std::runtime_error("Missing snapshot in journal");
+
+                Changes changes;
+                ScoreUtils::loadBinary(data, changes);
+                changes.apply(score);
+                break;
+            }
+
+            default:
+                throw std::runtime_error("Invalid record in journal");
+        }
+    }
+
+    if (!has_snapshot)
+        throw std::runtime_error("Missing snapshot in journal");
+}
+
+void
+BackupJournal::recover(const std::filesystem::path &path,
+                       const std::filesystem::path &backup_path)
+{
+    Score score;
+    load(path, score);
+
+    auto temp_path = backup_path;
+    temp_path += ".tmp";
+
+    {
+        std::ofstream output(temp_path, std::ios::out | std::ios::binary |
+                                            std::ios::trunc);
+        ScoreUtils::saveBinary(output, score);
+        output.close();
+
+        if (!output)
+        {
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            throw std::runtime_error("Failed to write recovered backup");
+        }
+    }
+
+    std::filesystem::rename(temp_path, backup_path);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,86 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef APP_BACKUPJOURNAL_H
+#define APP_BACKUPJOURNAL_H
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+class Score;
+
+/// A backup file that holds a full snapshot of a score, followed by records of
+/// the systems that were modified after the snapshot was taken. This allows
+/// small edits to be backed up without rewriting the entire score.
+///
+/// Each record is written with the binary score format. Since a record is
+/// only appended to the end of the file, a record that was not completely
+/// written (e.g. if the application crashed) is ignored when loading.
+class BackupJournal
+{
+public:
+    explicit BackupJournal(const std::filesystem::path &path);
+
+    const std::filesystem::path &getPath() const;
+
+    /// Replaces the contents of the journal with a snapshot of the score.
+    /// The snapshot is written to a temporary file first, so the previous
+    /// journal remains valid if this fails.
+    void saveSnapshot(const Score &score);
+
+    /// Appends the specified systems to the journal, along with the parts of
+    /// the score that are not stored in systems (players, instruments, etc).
+    /// If the file no longer matches what was previously written, a new
+    /// snapshot is saved instead.
+    void saveChanges(const Score &score, std::span<const int> systems);
+
+    /// Returns whether a snapshot has been saved.
+    bool hasSnapshot() const;
+
+    /// Returns whether the changes that have been appended are large enough
+    /// that a new snapshot should be saved instead.
+    bool needsCompaction() const;
+
+    /// Loads the score by replaying the snapshot and changes in the journal.
+    /// @throw std::runtime_error if the journal is invalid.
+    static void load(const std::filesystem::path &path, Score &score);
+
+    /// Loads the journal and saves the score as a binary file at
+    /// backup_path. The file is written to a temporary path and then renamed,
+    /// and the journal is only removed once the backup file is complete.
+    /// @throw std::runtime_error if the journal is invalid or the backup file
+    /// could not be written.
+    static void recover(const std::filesystem::path &path,
+                        const std::filesystem::path &backup_path);
+
+    /// Returns a name for the journal of the given file, without an
+    /// extension. This includes a hash of the file's full path, so that files
+    /// with the same name in different directories have separate journals
+    /// (e.g. "song.0123456789abcdef").
+    static std::filesystem::path getName(const std::filesystem::path &orig_path);
+
+    /// The file extension for journals.
+    static constexpr const char *FILE_EXTENSION = ".pt2j";
+
+private:
+    std::filesystem::path myPath;
+    std::uintmax_t mySnapshotSize = 0;
+    std::uintmax_t myChangesSize = 0;
+};
+
+#endif
@@ -22,6 +22,7 @@
 #include <score/system.h>
 
 #include <algorithm>
+#include <utility>
 
 Caret::Caret(Score &score, const ViewOptions &options)
     : myLocation(score), myViewOptions(options), myInPlaybackMode(false)
@@ -57,7 +58,8 @@ void Caret::moveHorizontal(int offset)
 
 void Caret::moveVertical(int offset)
 {
-    const int numStrings = myLocation.getStaff().getStringCount();
+    const int numStrings =
+        std::as_const(myLocation).getStaff().getStringCount();
     myLocation.setString((myLocation.getString() + offset + numStrings) %
                          numStrings);
 
@@ -96,8 +98,8 @@ void Caret::moveStaff(int offset)
 
 void Caret::moveToStaff(int staff)
 {
-    const int num_staves =
-        static_cast<int>(myLocation.getSystem().getStaves().size());
+    const System &system = std::as_const(myLocation).getSystem();
+    const int num_staves = static_cast<int>(system.getStaves().size());
     staff = std::clamp(staff, 0, num_staves - 1);
 
     const bool is_increasing = staff >= myLocation.getStaffIndex();
@@ -122,13 +124,14 @@ void Caret::moveToStaff(int staff)
 
 bool Caret::moveToNextBar()
 {
-    const Barline *nextBar = myLocation.getSystem().getNextBarline(
+    const System &system = std::as_const(myLocation).getSystem();
+    const Barline *nextBar = system.getNextBarline(
                 myLocation.getPositionIndex());
     if (!nextBar)
         return false;
 
     // Move into the next system if necessary.
-    if (*nextBar == myLocation.getSystem().getBarlines().back())
+    if (*nextBar == system.getBarlines().back())
         return moveToSystem(myLocation.getSystemIndex() + 1, true);
     else
     {
@@ -139,7 +142,7 @@ bool Caret::moveToNextBar()
 
 void Caret::moveToPrevBar()
 {
-    const System &system = myLocation.getSystem();
+    const System &system = std::as_const(myLocation).getSystem();
     const Barline *prevBar = system.getPreviousBarline(
                 myLocation.getPositionIndex());
     if (prevBar)
@@ -153,7 +156,7 @@ void Caret::moveToPrevBar()
         moveToSystem(myLocation.getSystemIndex() - 1, true);
 
         // Move to the last barline if possible.
-        const System &newSystem = myLocation.getSystem();
+        const System &newSystem = std::as_const(myLocation).getSystem();
         const size_t count = newSystem.getBarlines().size();
         if (count > 2)
             moveToPosition(newSystem.getBarlines()[count - 2].getPosition());
@@ -180,7 +183,8 @@ int Caret::getLastSystemIndex() const
 void Caret::moveToPosition(int position)
 {
     // Allow moving to the last barline's position (inclusive)
-    int last_pos = myLocation.getSystem().getBarlines().back().getPosition();
+    const int last_pos =
+        std::as_const(myLocation).getSystem().getBarlines().back().getPosition();
     myLocation.setPositionIndex(std::clamp(position, 0, last_pos));
     myLocation.setSelectionStart(myLocation.getPositionIndex());
 
@@ -198,10 +202,10 @@ bool Caret::moveToSystem(int system, bool keepStaff)
             myLocation.setStaffIndex(0);
         else
         {
+            const System &newSystem = std::as_const(myLocation).getSystem();
             myLocation.setStaffIndex(
                 std::clamp(myLocation.getStaffIndex(), 0,
-                           static_cast<int>(
-                               myLocation.getSystem().getStaves().size() - 1)));
+                           static_cast<int>(newSystem.getStaves().size() - 1)));
         }
 
         myLocation.setPositionIndex(0);
@@ -151,7 +151,8 @@ int DocumentManager::findDocument(const Document::PathType &filepath)
 }
 
 Document::Document()
-    : myCaret(myScore, myViewOptions)
+    : myCaret(myScore, myViewOptions),
+      myMidiCache(std::make_shared<MidiBarCache>())
 {
 }
 
@@ -194,3 +195,8 @@ Caret &Document::getCaret()
 {
     return myCaret;
 }
+
+const std::shared_ptr<MidiBarCache> &Document::getMidiCache() const
+{
+    return myMidiCache;
+}
@@ -21,6 +21,7 @@
 #include <app/viewoptions.h>
 #include <app/caret.h>
 #include <filesystem>
+#include <midi/midibarcache.h>
 #include <optional>
 #include <memory>
 #include <score/score.h>
@@ -54,11 +55,17 @@ public:
     const Caret &getCaret() const;
     Caret &getCaret();
 
+    /// Returns the MIDI events generated for the score during playback, which
+    /// must be invalidated when the score is edited. This is shared with the
+    /// MIDI thread.
+    const std::shared_ptr<MidiBarCache> &getMidiCache() const;
+
 private:
     std::optional<PathType> myFilename;
     Score myScore;
     ViewOptions myViewOptions;
     Caret myCaret;
+    std::shared_ptr<MidiBarCache> myMidiCache;
 };
 
 /// Class for managing open documents.
@@ -143,6 +143,7 @@
 #include <QRegularExpression>
 #include <QScrollArea>
 #include <QTabBar>
+#include <QTimer>
 #include <QUrl>
 #include <QVBoxLayout>
 
@@ -152,12 +153,16 @@
 
 #include <util/tostring.h>
 #include <util/version.h>
+#include <utility>
 
 #include <widgets/instruments/instrumentpanel.h>
 #include <widgets/mixer/mixer.h>
 #include <widgets/playback/playbackwidget.h>
 #include <widgets/toolbox/toolbox.h>
 
+/// How often the caret is updated during playback (milliseconds).
+static constexpr int PLAYBACK_POSITION_INTERVAL = 15;
+
 PowerTabEditor::PowerTabEditor()
     : QMainWindow(nullptr),
       mySettingsManager(std::make_unique<SettingsManager>()),
@@ -522,7 +527,7 @@ void PowerTabEditor::printDocument()
 
 void PowerTabEditor::bulkConverter()
 {
-    BulkConverterDialog dialog(this, myFileFormatManager);
+    BulkConverterDialog dialog(this, myFileFormatManager, *mySettingsManager);
     dialog.exec();
 }
 
@@ -617,15 +622,19 @@ PowerTabEditor::createMidiThread()
             [this](const QString &msg)
             { QMessageBox::critical(this, tr("Midi Error"), msg); });
 
-    connect(myMidiPlayer, &MidiPlayer::playbackSystemChanged, this,
-            &PowerTabEditor::moveCaretToSystem);
-    connect(myMidiPlayer, &MidiPlayer::playbackPositionChanged, this,
-            &PowerTabEditor::moveCaretToPosition);
     connect(myMidiPlayer, &MidiPlayer::playbackFinished, this,
             [this]() { startStopPlayback(); });
 
-    // Start the thread and setup the MIDI device in the background.
-    myMidiThread->start();
+    // The caret follows playback by polling the MIDI player, rather than the
+    // MIDI thread sending a signal for every position change.
+    myPlaybackPositionTimer = new QTimer(this);
+    myPlaybackPositionTimer->setInterval(PLAYBACK_POSITION_INTERVAL);
+    connect(myPlaybackPositionTimer, &QTimer::timeout, this,
+            &PowerTabEditor::updatePlaybackPosition);
+
+    // Start the thread and setup the MIDI device in the background. Use a
+    // high priority since it is responsible for the playback timing.
+    myMidiThread->start(QThread::TimeCriticalPriority);
     QMetaObject::invokeMethod(myMidiPlayer, &MidiPlayer::init,
                               Qt::QueuedConnection);
 }
@@ -659,12 +668,19 @@ void PowerTabEditor::startStopPlayback(bool from_measure_start)
         const ScoreLocation &location = getLocation();
         MidiPlaybackSettings initial_settings(
             myPlaybackWidget->getPlaybackSpeed(), location.getScore());
+        std::shared_ptr<MidiBarCache> midi_cache =
+            myDocumentManager->getCurrentDocument().getMidiCache();
+
+        // Discard any positions left over from the previous playback.
+        myMidiPlayer->takePlaybackPosition();
+        myPlaybackPositionTimer->start();
 
         QMetaObject::invokeMethod(
             myMidiPlayer,
             [=, this]()
             {
-                myMidiPlayer->playScore(location, initial_settings);
+                myMidiPlayer->playScore(location, initial_settings,
+                                        midi_cache);
             },
             Qt::QueuedConnection);
     }
@@ -672,6 +688,7 @@ void PowerTabEditor::startStopPlayback(bool from_measure_start)
     {
         // Ensure playback has finished.
         myMidiPlayer->stopPlayback();
+        myPlaybackPositionTimer->stop();
 
         myPlayPauseCommand->setText(tr("Play"));
         getCaret().setIsInPlaybackMode(false);
@@ -682,8 +699,23 @@ void PowerTabEditor::startStopPlayback(bool from_measure_start)
     }
 }
 
+void PowerTabEditor::updatePlaybackPosition()
+{
+    const std::optional<SystemLocation> location =
+        myMidiPlayer->takePlaybackPosition();
+    if (!location)
+        return;
+
+    if (location->getSystem() != getLocation().getSystemIndex())
+        moveCaretToSystem(location->getSystem());
+
+    moveCaretToPosition(location->getPosition());
+}
+
 void PowerTabEditor::redrawSystem(int index)
 {
+    myDocumentManager->getCurrentDocument().getMidiCache()->invalidateSystem(
+        index);
     getCaret().moveToValidPosition();
     getScoreArea()->redrawSystem(index);
     updateCommands();
@@ -692,6 +724,7 @@ void PowerTabEditor::redrawSystem(int index)
 void PowerTabEditor::redrawScore()
 {
     Document &doc = myDocumentManager->getCurrentDocument();
+    doc.getMidiCache()->clear();
     doc.validateViewOptions();
     getCaret().moveToValidPosition();
     getScoreArea()->renderDocument(doc);
@@ -1128,7 +1161,7 @@ void PowerTabEditor::updateNoteDuration(Position::DurationType duration)
     // Set the duration for future notes that are added.
     myActiveDurationType = duration;
 
-    if (!getLocation().getSelectedPositions().empty())
+    if (!std::as_const(getLocation()).getSelectedPositions().empty())
     {
         myUndoManager->push(
             new EditNoteDuration(getLocation(), duration, false),
@@ -1153,8 +1186,8 @@ static Position::DurationType changeDuration(Position::DurationType duration,
 
 void PowerTabEditor::changeNoteDuration(bool increase)
 {
-    std::vector<Position *> selected_positions =
-        getLocation().getSelectedPositions();
+    std::vector<const Position *> selected_positions =
+        std::as_const(getLocation()).getSelectedPositions();
 
     if (selected_positions.empty())
     {
@@ -1197,7 +1230,7 @@ void PowerTabEditor::changeNoteDuration(bool increase)
 
 void PowerTabEditor::addDot()
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Position *pos = location.getPosition();
     Q_ASSERT(pos);
 
@@ -1219,7 +1252,7 @@ void PowerTabEditor::addDot()
 
 void PowerTabEditor::removeDot()
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Position *pos = location.getPosition();
     Q_ASSERT(pos);
 
@@ -1241,7 +1274,7 @@ void PowerTabEditor::removeDot()
 
 void PowerTabEditor::editTiedNote()
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Voice &voice = location.getVoice();
     const Voice *prev_voice = VoiceUtils::getAdjacentVoice(location, -1);
 
@@ -1277,7 +1310,8 @@ void PowerTabEditor::editTiedNote()
         }
         else
         {
-            std::vector<Position *> positions = location.getSelectedPositions();
+            std::vector<const Position *> positions =
+                location.getSelectedPositions();
             // Check that all selected notes can be tied.
             for (const Position *pos : positions)
             {
@@ -1300,8 +1334,9 @@ void PowerTabEditor::editTiedNote()
 
 void PowerTabEditor::editIrregularGrouping(bool setAsTriplet)
 {
-    ScoreLocation &location = getLocation();
-    std::vector<Position *> selectedPositions = location.getSelectedPositions();
+    const ScoreLocation &location = getLocation();
+    std::vector<const Position *> selectedPositions =
+        location.getSelectedPositions();
     Q_ASSERT(!selectedPositions.empty());
 
     if (selectedPositions.size() == 1)
@@ -1346,7 +1381,7 @@ void PowerTabEditor::editIrregularGrouping(bool setAsTriplet)
 
 void PowerTabEditor::addRest()
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Position *pos = location.getPosition();
     const Position::DurationType duration =
         pos ? pos->getDurationType() : myActiveDurationType;
@@ -1628,7 +1663,7 @@ void PowerTabEditor::editRepeatEnding(bool remove)
 
 void PowerTabEditor::updateDynamic(VolumeLevel volume)
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Dynamic *currentDynamic = ScoreUtils::findByPosition(
                 location.getStaff().getDynamics(), location.getPositionIndex());
     Dynamic newDynamic(location.getPositionIndex(), volume);
@@ -1658,7 +1693,7 @@ void PowerTabEditor::updateDynamic(VolumeLevel volume)
 void
 PowerTabEditor::editDynamic(bool remove)
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Dynamic *dynamic = ScoreUtils::findByPosition(
         location.getStaff().getDynamics(), location.getPositionIndex());
 
@@ -1768,7 +1803,7 @@ PowerTabEditor::editTremoloBar(bool remove)
 
 void PowerTabEditor::editHammerPull()
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Voice &voice = location.getVoice();
     const int position = location.getPositionIndex();
     const Note *note = location.getNote();
@@ -1786,7 +1821,7 @@ void PowerTabEditor::editHammerPull()
 
 void PowerTabEditor::editArtificialHarmonic()
 {
-    auto &location = getLocation();
+    const ScoreLocation &location = getLocation();
 
     if (!location.getNote()->hasArtificialHarmonic())
     {
@@ -2079,7 +2114,7 @@ bool PowerTabEditor::eventFilter(QObject *object, QEvent *event)
         if (keyEvent->key() >= Qt::Key_0 && keyEvent->key() <= Qt::Key_9)
         {
             const int number = keyEvent->key() - Qt::Key_0;
-            ScoreLocation &location = getLocation();
+            const ScoreLocation &location = getLocation();
 
             // Add a space if the user is attempting to add a note at the end of
             // the system.
@@ -3852,7 +3887,7 @@ void PowerTabEditor::updateCommands()
     if (myIsPlaying)
         return;
 
-    ScoreLocation location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Score &score = location.getScore();
     if (score.getSystems().empty())
         return;
@@ -4161,7 +4196,7 @@ void PowerTabEditor::enableEditing(bool enable)
 
 void PowerTabEditor::editRest(Position::DurationType duration)
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Position *pos = location.getPosition();
 
     // Set the duration for future notes / rests that are added.
@@ -4274,7 +4309,7 @@ void PowerTabEditor::updateLocationLabel()
 
 void PowerTabEditor::editKeySignature()
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
 
     const Barline *barline = location.getBarline();
     Q_ASSERT(barline);
@@ -4289,7 +4324,7 @@ void PowerTabEditor::editKeySignature()
 
 void PowerTabEditor::editTimeSignature()
 {
-    ScoreLocation &location = getLocation();
+    const ScoreLocation &location = getLocation();
 
     const Barline *barline = location.getBarline();
     Q_ASSERT(barline);
@@ -4305,11 +4340,11 @@ void PowerTabEditor::editTimeSignature()
 
 void PowerTabEditor::editBarline()
 {
-	ScoreLocation &location = getLocation();
-    System &system = location.getSystem();
+    const ScoreLocation &location = getLocation();
+    const System &system = location.getSystem();
 
-    Barline *barline = ScoreUtils::findByPosition(system.getBarlines(),
-                                                  location.getPositionIndex());
+    const Barline *barline = ScoreUtils::findByPosition(
+        system.getBarlines(), location.getPositionIndex());
 
     if (barline)
     {
@@ -4342,8 +4377,9 @@ void PowerTabEditor::editBarline()
 void PowerTabEditor::editSimplePositionProperty(Command *command,
                                                 Position::SimpleProperty property)
 {
-    ScoreLocation &location = getLocation();
-    std::vector<Position *> selectedPositions = location.getSelectedPositions();
+    const ScoreLocation &location = getLocation();
+    std::vector<const Position *> selectedPositions =
+        location.getSelectedPositions();
     if (selectedPositions.empty())
         return;
 
@@ -4373,8 +4409,8 @@ void PowerTabEditor::editSimplePositionProperty(Command *command,
 void PowerTabEditor::editSimpleNoteProperty(Command *command,
                                             Note::SimpleProperty property)
 {
-    ScoreLocation &location = getLocation();
-    std::vector<Note *> selectedNotes = location.getSelectedNotes();
+    const ScoreLocation &location = getLocation();
+    std::vector<const Note *> selectedNotes = location.getSelectedNotes();
     if (selectedNotes.empty())
         return;
 
@@ -4411,7 +4447,7 @@ void PowerTabEditor::insertStaff(int index)
 {
     StaffDialog dialog(this);
 
-    const Staff &current_staff = getLocation().getStaff();
+    const Staff &current_staff = std::as_const(getLocation()).getStaff();
     dialog.setStringCount(current_staff.getStringCount());
 
     if (dialog.exec() == QDialog::Accepted)
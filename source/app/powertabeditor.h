@@ -40,6 +40,7 @@ class PlaybackWidget;
 class Player;
 class QActionGroup;
 class QThread;
+class QTimer;
 class RecentFiles;
 class ScoreArea;
 class ScoreLocation;
@@ -117,6 +118,8 @@ private slots:
 
     /// Starts or stops playback of the score.
     void startStopPlayback(bool from_measure_start = false);
+    /// Moves the caret to the latest position from the MIDI thread.
+    void updatePlaybackPosition();
 
     /// Redraws only the given system.
     void redrawSystem(int);
@@ -434,6 +437,8 @@ private:
     std::unique_ptr<AutoBackup> myAutoBackup;
     std::unique_ptr<QThread> myMidiThread;
     MidiPlayer *myMidiPlayer = nullptr;
+    /// Polls for playback position changes while playing.
+    QTimer *myPlaybackPositionTimer = nullptr;
     std::unique_ptr<TuningDictionary> myTuningDictionary;
     /// Tracks whether we are currently in playback mode.
     bool myIsPlaying;
@@ -18,13 +18,16 @@
 #include "scorearea.h"
 
 #include <app/documentmanager.h>
+#include <algorithm>
 #include <app/settings.h>
 #include <chrono>
-#include <future>
+#include <cmath>
+#include <functional>
 #include <painters/caretpainter.h>
 #include <painters/chorddiagrampainter.h>
 #include <painters/scoreclickevent.h>
 #include <painters/scoreinforenderer.h>
+#include <painters/scoreprinter.h>
 #include <painters/systemrenderer.h>
 #include <QDebug>
 #include <QGraphicsItem>
@@ -32,6 +35,7 @@
 #include <QPrinter>
 #include <QScrollBar>
 #include <score/score.h>
+#include <util/parallelfor.h>
 
 void ScoreArea::Scene::dragEnterEvent(QGraphicsSceneDragDropEvent *event)
 {
@@ -40,6 +44,7 @@ void ScoreArea::Scene::dragEnterEvent(QGraphicsSceneDragDropEvent *event)
 
 ScoreArea::ScoreArea(SettingsManager &settings_manager, QWidget *parent)
     : QGraphicsView(parent),
+      myDocument(nullptr),
       myScoreInfoBlock(nullptr),
       myChordDiagramList(nullptr),
       myCaretPainter(nullptr),
@@ -49,6 +54,10 @@ ScoreArea::ScoreArea(SettingsManager &settings_manager, QWidget *parent)
 {
     setScene(&myScene);
 
+    // Render systems as they are scrolled into view.
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this,
+            [this]() { renderVisibleSystems(); });
+
     // Configure the palette for the light theme and printing.
     myLightPalette.setColor(QPalette::Base, Qt::white);
     myLightPalette.setColor(QPalette::Text, Qt::black);
@@ -78,10 +87,16 @@ ScoreArea::ScoreArea(SettingsManager &settings_manager, QWidget *parent)
             ScoreItemAction action) { itemClicked(item, location, action); });
 }
 
+/// Maximum number of fully rendered systems to keep around. Systems outside of
+/// the area around the viewport are discarded when this is exceeded.
+static constexpr int MAX_RENDERED_SYSTEMS = 64;
+
 void ScoreArea::renderDocument(const Document &document)
 {
-    myScene.clear();
     myRenderedSystems.clear();
+    myIsSystemRendered.clear();
+    myScene.clear();
+    myLayoutCache.clear();
     myDocument = &document;
 
     refreshZoom();
@@ -91,7 +106,8 @@ void ScoreArea::renderDocument(const Document &document)
     auto start = std::chrono::high_resolution_clock::now();
 
     myCaretPainter = new CaretPainter(
-        document.getCaret(), document.getViewOptions(), *myActivePalette);
+        document.getCaret(), document.getViewOptions(), *myActivePalette,
+        myLayoutCache);
     myCaretPainter->subscribeToMovement([this]() {
         adjustScroll();
     });
@@ -103,37 +119,20 @@ void ScoreArea::renderDocument(const Document &document)
         score, myActivePalette->text().color(), myClickEvent,
         LayoutInfo::STAFF_WIDTH);
 
-    myRenderedSystems.reserve(static_cast<int>(score.getSystems().size()));
-    for (unsigned int i = 0; i < score.getSystems().size(); ++i)
+    const int num_systems = static_cast<int>(score.getSystems().size());
+    myRenderedSystems.reserve(num_systems);
+    for (int i = 0; i < num_systems; ++i)
         myRenderedSystems.append(nullptr);
-
-#if 0
-    const int num_threads = std::thread::hardware_concurrency();
-#else
-    const int num_threads = 1;
-#endif
-    std::vector<std::future<void>> tasks;
-    const int work_size = myRenderedSystems.size() / num_threads;
-    qDebug() << "Using" << num_threads << "worker thread(s)";
-
-    for (int i = 0; i < num_threads; ++i)
-    {
-        const int left = i * work_size;
-        const int right = (i == num_threads - 1) ? myRenderedSystems.size()
-                                                 : (i + 1) * work_size;
-
-        tasks.push_back(std::async(std::launch::async, [&](int left, int right)
-        {
-            for (int i = left; i < right; ++i)
-            {
-                SystemRenderer render(this, score, document.getViewOptions());
-                myRenderedSystems[i] = render(score.getSystems()[i], i);
-            }
-        }, left, right));
-    }
-
-    for (auto &&task : tasks)
-        task.get();
+    myIsSystemRendered.assign(num_systems, false);
+
+    // Only compute the size of each system for now. The systems are fully
+    // rendered once they are scrolled into view (see renderVisibleSystems()).
+    Util::parallelFor(num_systems, [&](int i) {
+        SystemRenderer render(score, document.getViewOptions(),
+                              myLayoutCache, *myActivePalette, myClickEvent);
+        myRenderedSystems[i] =
+            render.createPlaceholder(score.getSystems()[i], i);
+    });
 
     double height = 0;
     // Score info.
@@ -161,6 +160,8 @@ void ScoreArea::renderDocument(const Document &document)
     // creation and never shrinks (bug #443).
     myScene.setSceneRect(myScene.itemsBoundingRect());
 
+    renderVisibleSystems();
+
     auto end = std::chrono::high_resolution_clock::now();
     qDebug() << "Score rendered in"
              << std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -168,14 +169,108 @@ void ScoreArea::renderDocument(const Document &document)
     qDebug() << "Rendered " << myScene.items().size() << "items";
 }
 
+void ScoreArea::renderSystems(const std::vector<int> &indices)
+{
+    if (indices.empty())
+        return;
+
+    const Score &score = myDocument->getScore();
+    std::vector<QGraphicsItem *> systems(indices.size(), nullptr);
+
+    Util::parallelFor(static_cast<int>(indices.size()), [&](int i) {
+        SystemRenderer render(score, myDocument->getViewOptions(),
+                              myLayoutCache, *myActivePalette, myClickEvent);
+        systems[i] = render(score.getSystems()[indices[i]], indices[i]);
+    });
+
+    for (size_t i = 0; i < indices.size(); ++i)
+        replaceSystem(indices[i], systems[i], true);
+}
+
+void ScoreArea::replaceSystem(int index, QGraphicsItem *item, bool rendered)
+{
+    QGraphicsItem *old_item = myRenderedSystems[index];
+    item->setPos(old_item->pos());
+    delete old_item;
+
+    myScene.addItem(item);
+    myRenderedSystems[index] = item;
+    myIsSystemRendered[index] = rendered;
+}
+
+void ScoreArea::renderVisibleSystems()
+{
+    if (!myDocument || myRenderedSystems.empty())
+        return;
+
+    // Also render the systems within a screen's height of the visible area,
+    // so that they are ready before being scrolled into view.
+    const QRectF visible_rect =
+        mapToScene(viewport()->rect()).boundingRect();
+    const QRectF render_rect =
+        visible_rect.adjusted(0, -visible_rect.height(), 0,
+                              visible_rect.height());
+
+    std::vector<int> pending;
+    int num_rendered = 0;
+    for (int i = 0, n = myRenderedSystems.size(); i < n; ++i)
+    {
+        if (myIsSystemRendered[i])
+            ++num_rendered;
+        else if (myRenderedSystems[i]->sceneBoundingRect().intersects(
+                     render_rect))
+        {
+            pending.push_back(i);
+        }
+    }
+
+    renderSystems(pending);
+    num_rendered += static_cast<int>(pending.size());
+
+    if (num_rendered <= MAX_RENDERED_SYSTEMS)
+        return;
+
+    // Discard the systems that are furthest away from the visible area.
+    std::vector<std::pair<double, int>> candidates;
+    for (int i = 0, n = myRenderedSystems.size(); i < n; ++i)
+    {
+        const QRectF rect = myRenderedSystems[i]->sceneBoundingRect();
+        if (myIsSystemRendered[i] && !rect.intersects(render_rect))
+        {
+            candidates.emplace_back(
+                std::abs(rect.center().y() - visible_rect.center().y()), i);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), std::greater<>());
+
+    const Score &score = myDocument->getScore();
+    SystemRenderer render(score, myDocument->getViewOptions(), myLayoutCache,
+                          *myActivePalette, myClickEvent);
+    for (auto [distance, index] : candidates)
+    {
+        if (num_rendered <= MAX_RENDERED_SYSTEMS)
+            break;
+
+        replaceSystem(index,
+                      render.createPlaceholder(score.getSystems()[index],
+                                               index),
+                      false);
+        --num_rendered;
+    }
+}
+
 void ScoreArea::redrawSystem(int index)
 {
     // Delete and remove the system from the scene.
     delete myRenderedSystems.takeAt(index);
+    myLayoutCache.invalidateSystem(index);
 
     const Score &score = myDocument->getScore();
-    SystemRenderer render(this, score, myDocument->getViewOptions());
+    SystemRenderer render(score, myDocument->getViewOptions(), myLayoutCache,
+                          *myActivePalette, myClickEvent);
     QGraphicsItem *newSystem = render(score.getSystems()[index], index);
+    myIsSystemRendered[index] = true;
 
     double height = 0;
     if (index > 0)
@@ -205,76 +300,19 @@ void ScoreArea::redrawSystem(int index)
     // The spacing may have changed, so update the caret's position and redraw
     // it.
     myCaretPainter->updatePosition();
+
+    // Shifting the systems may have moved other placeholders into view.
+    renderVisibleSystems();
 }
 
 void ScoreArea::print(QPrinter &printer)
 {
-    QPainter painter;
-    painter.begin(&printer);
-
-    // Use the light palette for printing.
-    const QPalette *orig_palette = myActivePalette;
-    myActivePalette = &myLightPalette;
-
-    // Render the document after the palette has been set to print colors
-    this->renderDocument(*myDocument);
-
-    // Hide the caret when printing.
-    myCaretPainter->hide();
-
-    // Scale the score based on the ratio between the device's width and our
-    // normal staff width in the UI.
-    QRectF target_rect(0, 0, painter.device()->width(),
-                       painter.device()->height());
-    const double ratio = target_rect.width() / LayoutInfo::STAFF_WIDTH;
-
-    QList<QGraphicsItem*> items;
-    items.append(myScoreInfoBlock);
-    items.append(myChordDiagramList);
-    items.append(myRenderedSystems);
-
-    for (int i = 0, n = items.length(); i < n; ++i)
-    {
-        const QGraphicsItem *item = items[i];
-        const QRectF source_rect = item->sceneBoundingRect();
-        // Skip if e.g. the score info block is completely empty to avoid
-        // division by zero and other issues.
-        if (source_rect.height() == 0.0)
-            continue;
-
-        if (i > 0)
-        {
-            const QGraphicsItem *prev_item = items[i - 1];
-            const double spacing =
-                source_rect.y() - prev_item->sceneBoundingRect().bottom();
-            target_rect.moveTop(target_rect.y() + spacing * ratio);
-        }
-
-        // Figure out how much space the item will take up on the page, and
-        // determine if we need a page break.
-        const float height = source_rect.height() * ratio;
-        if (target_rect.y() + height > painter.device()->height())
-        {
-            printer.newPage();
-            target_rect.moveTop(0);
-        }
-
-        // Draw the system on the page.
-        target_rect.setLeft(source_rect.left() * ratio);
-        target_rect.setWidth(source_rect.width() * ratio);
-        target_rect.setHeight(source_rect.height() * ratio);
-        scene()->render(&painter, target_rect, source_rect);
-
-        // Set the location for the next item.
-        target_rect.moveTop(target_rect.y() + height);
-    }
-
-    myCaretPainter->show();
-    painter.end();
-
-    // Revert to the original app palette and re-render the document
-    myActivePalette = orig_palette;
-    renderDocument(*myDocument);
+    // Render a separate copy of the score with the light palette, rather than
+    // re-rendering the scene that is displayed on screen.
+    ScorePrinter score_printer(myDocument->getScore(),
+                               myDocument->getViewOptions(), myLayoutCache,
+                               myLightPalette, mySystemSpacing);
+    score_printer.print(printer);
 }
 
 void ScoreArea::adjustScroll()
@@ -289,6 +327,12 @@ void ScoreArea::adjustScroll()
         ensureVisible(myCaretPainter->sceneBoundingRect(), 0, 0);
 }
 
+void ScoreArea::resizeEvent(QResizeEvent *event)
+{
+    QGraphicsView::resizeEvent(event);
+    renderVisibleSystems();
+}
+
 void ScoreArea::focusInEvent(QFocusEvent *)
 {
     myScene.update(myCaretPainter->sceneBoundingRect());
@@ -307,6 +351,9 @@ void ScoreArea::refreshZoom()
     QTransform xform;
     xform.scale(scale_factor, scale_factor);
     setTransform(xform);
+
+    // Zooming out can bring more systems into view.
+    renderVisibleSystems();
 }
 
 const QPalette *ScoreArea::getPalette() const
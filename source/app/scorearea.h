@@ -21,6 +21,8 @@
 #include "settingsmanager.h"
 
 #include <memory>
+#include <painters/layoutcache.h>
+#include <vector>
 #include <QGraphicsScene>
 #include <QGraphicsView>
 #include <score/staff.h>
@@ -73,8 +75,21 @@ protected:
     virtual void focusInEvent(QFocusEvent *event) override;
     virtual void focusOutEvent(QFocusEvent *event) override;
     bool event(QEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
 
 private:
+    /// Fully renders the systems that are in or near the visible area, and
+    /// discards rendered systems far away from it if too many are in memory.
+    void renderVisibleSystems();
+
+    /// Replaces the placeholders for the specified systems with fully
+    /// rendered systems.
+    void renderSystems(const std::vector<int> &indices);
+
+    /// Swaps the item in the scene for the specified system, keeping its
+    /// position.
+    void replaceSystem(int index, QGraphicsItem *item, bool rendered);
+
     /// Adjusts the scroll location whenever the caret moves.
     void adjustScroll();
 
@@ -82,13 +97,20 @@ private:
     void loadTheme(const SettingsManager &settings_manager, bool redraw = true);
     void loadSystemSpacing(const SettingsManager &settings_manager, bool redraw = true);
 
+    /// Declared before the scene so that it outlives any items that refer
+    /// to it.
+    LayoutCache myLayoutCache;
     Scene myScene;
     const Document *myDocument;
     QGraphicsItem *myScoreInfoBlock;
     QGraphicsItem *myChordDiagramList;
     double myHeaderSize = 0;
     double mySystemSpacing = 0;
+    /// The item for each system, which is either the fully rendered system
+    /// or a placeholder if it hasn't been scrolled into view yet.
     QList<QGraphicsItem *> myRenderedSystems;
+    /// Whether each entry of myRenderedSystems is a fully rendered system.
+    std::vector<bool> myIsSystemRendered;
     CaretPainter *myCaretPainter;
     /// The color palette from the parent widget.
     const QPalette *myDefaultPalette;
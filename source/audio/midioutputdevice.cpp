@@ -84,9 +84,9 @@ MidiOutputDevice::stopAllNotes()
 }
 
 void
-MidiOutputDevice::sendMessage(const std::vector<uint8_t> &data)
+MidiOutputDevice::sendMessage(std::span<const uint8_t> data)
 {
-    myMidiOut->sendMessage(&data);
+    myMidiOut->sendMessage(data.data(), data.size());
 }
 
 bool MidiOutputDevice::sendMidiMessage(unsigned char a, unsigned char b,
@@ -28,6 +28,7 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -86,7 +87,7 @@ public:
         AllNotesOff = 123
     };
 
-    void sendMessage(const std::vector<uint8_t> &data);
+    void sendMessage(std::span<const uint8_t> data);
 
     // Stops notes on all channels. Useful if playback was interrupted.
     void stopAllNotes();
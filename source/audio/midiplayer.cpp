@@ -19,10 +19,13 @@
 
 #include <app/settingsmanager.h>
 #include <audio/midioutputdevice.h>
+#include <audio/midischeduler.h>
 #include <audio/settings.h>
 #include <boost/rational.hpp>
 #include <cassert>
 #include <chrono>
+#include <midi/midieventmerger.h>
+#include <midi/midieventstream.h>
 #include <midi/midifile.h>
 #include <score/generalmidi.h>
 #include <score/score.h>
@@ -35,10 +38,15 @@
 
 static const int METRONOME_CHANNEL = 9;
 
+/// Maximum number of position changes that can be waiting for the UI. If the
+/// UI falls behind, further updates are dropped rather than blocking playback.
+static constexpr size_t POSITION_QUEUE_SIZE = 256;
+
 using DurationType = std::chrono::duration<int, std::micro>;
 
 MidiPlayer::MidiPlayer(SettingsManager &settings_manager)
-    : mySettingsManager(settings_manager)
+    : mySettingsManager(settings_manager),
+      myPositionChanges(POSITION_QUEUE_SIZE)
 {
     mySettingsListener = settings_manager.subscribeToChanges(
         [&]()
@@ -150,29 +158,12 @@ loadMidiSettings(const SettingsManager &settings_manager,
         settings->get(Settings::MidiWideVibratoLevel);
 }
 
-static MidiEventList
-mergeMidiEvents(MidiFile &file)
-{
-    // Merge the MIDI evvents for each track.
-    MidiEventList events;
-    for (MidiEventList &track : file.getTracks())
-    {
-        track.convertToAbsoluteTicks();
-        events.concat(track);
-    }
-
-    // TODO - since each track is already sorted, an n-way merge should be
-    // faster.
-    std::stable_sort(events.begin(), events.end());
-    events.convertToDeltaTicks();
-
-    return events;
-}
-
 bool
-MidiPlayer::playEvents(MidiFile &file, const SystemLocation &start_location,
-                       const MidiPlaybackSettings &initial_settings,
-                       bool allow_count_in, const Score *score)
+MidiPlayer::playEvents(
+    const std::function<std::optional<MidiEvent>()> &next_event_fn,
+    int ticks_per_beat, const SystemLocation &start_location,
+    const MidiPlaybackSettings &initial_settings, bool allow_count_in,
+    const Score *score)
 {
     setPlaybackSettings(initial_settings);
 
@@ -181,19 +172,18 @@ MidiPlayer::playEvents(MidiFile &file, const SystemLocation &start_location,
         myIsPlaying = false;
     });
 
-    MidiEventList events = mergeMidiEvents(file);
-    const int ticks_per_beat = file.getTicksPerBeat();
-
     bool started = false;
     Midi::Tempo beat_duration = Midi::BEAT_DURATION_120_BPM;
     SystemLocation current_location = start_location;
-    DurationType clock_drift(0);
+    MidiScheduler scheduler(ticks_per_beat);
 
     std::array<uint16_t, Midi::NUM_MIDI_CHANNELS_PER_PORT> initial_pitch_wheel;
     initial_pitch_wheel.fill(Midi::DEFAULT_BEND);
 
-    for (const MidiEvent &event : events)
+    while (const std::optional<MidiEvent> next_event = next_event_fn())
     {
+        const MidiEvent &event = *next_event;
+
         if (!myIsPlaying)
             return false;
 
@@ -236,30 +226,17 @@ MidiPlayer::playEvents(MidiFile &file, const SystemLocation &start_location,
                 if (allow_count_in)
                     performCountIn(*score, event.getLocation(), beat_duration);
 
+                scheduler.start();
                 started = true;
             }
         }
 
-        auto start_timestamp = std::chrono::high_resolution_clock::now();
-
         const int delta = event.getTicks();
         assert(delta >= 0);
 
-		// Compute the time in microseconds that we should sleep for, and then
-        // adjust for accumulated timing errors (since sleep_for() is not
-        // perfectly precise).
-        auto sleep_duration = DurationType(static_cast<int64_t>(
-            boost::rational_cast<int64_t>(
-                boost::rational<int64_t>(delta, ticks_per_beat) *
-                beat_duration.count()) *
-            (100.0 / myPlaybackSpeed)));
-
-        auto error_correction = std::min(sleep_duration, clock_drift);
-        clock_drift -= error_correction;
-        sleep_duration -= error_correction;
-
-        if (sleep_duration.count() != 0)
-            std::this_thread::sleep_for(sleep_duration);
+        // Wait until the event's deadline, which is measured from the start
+        // of playback so that timing errors don't accumulate.
+        scheduler.waitForEvent(delta, beat_duration, myPlaybackSpeed);
 
         // Don't play metronome events if the metronome is disabled.
         // Tempo change events also don't need to be sent since they are
@@ -288,7 +265,8 @@ MidiPlayer::playEvents(MidiFile &file, const SystemLocation &start_location,
                 myDevice->setVolume(channel, event.getVolume());
         }
 
-        // Notify listeners of the current playback position.
+        // Notify the UI of the current playback position, without waiting
+        // for it.
         if (event.getLocation() != current_location)
         {
             const SystemLocation &new_location = event.getLocation();
@@ -296,21 +274,10 @@ MidiPlayer::playEvents(MidiFile &file, const SystemLocation &start_location,
             // Don't move backwards unless a repeat occurred.
             if (new_location >= current_location || event.isPositionChange())
             {
-                if (new_location.getSystem() != current_location.getSystem())
-                    emit playbackSystemChanged(new_location.getSystem());
-
-                emit playbackPositionChanged(new_location.getPosition());
-
+                myPositionChanges.tryPush(SystemLocation(new_location));
                 current_location = new_location;
             }
         }
-
-        // Accumulate any difference between the desired delta time and what
-        // actually happened.
-        auto end_timestamp = std::chrono::high_resolution_clock::now();
-        auto actual_duration = std::chrono::duration_cast<DurationType>(
-            end_timestamp - start_timestamp);
-        clock_drift += actual_duration - sleep_duration;
     }
 
     return true;
@@ -318,7 +285,8 @@ MidiPlayer::playEvents(MidiFile &file, const SystemLocation &start_location,
 
 void
 MidiPlayer::playScore(const ConstScoreLocation &start_score_location,
-                      const MidiPlaybackSettings &initial_settings)
+                      const MidiPlaybackSettings &initial_settings,
+                      std::shared_ptr<MidiBarCache> cache)
 {
     myStartLocation.emplace(start_score_location);
     const Score &score = start_score_location.getScore();
@@ -328,14 +296,15 @@ MidiPlayer::playScore(const ConstScoreLocation &start_score_location,
     options.myRecordPositionChanges = true;
     loadMidiSettings(mySettingsManager, options);
 
-    MidiFile file;
-    file.load(score, options);
+    // Generate the events while playing, so that playback can start
+    // immediately.
+    MidiEventStream events(score, options, cache.get());
 
     const SystemLocation start_location(myStartLocation->getSystemIndex(),
                                         myStartLocation->getPositionIndex());
 
-    if (playEvents(file, start_location, initial_settings, true,
-                   &score))
+    if (playEvents([&]() { return events.next(); }, events.getTicksPerBeat(),
+                   start_location, initial_settings, true, &score))
     {
         emit playbackFinished();
     }
@@ -364,7 +333,11 @@ MidiPlayer::playSingleNote(MidiFile &file, const ConstScoreLocation &location,
     SystemLocation start_location(location.getSystemIndex(),
                                   location.getPositionIndex());
 
-    playEvents(file, start_location, initial_settings,
+    // Stream the events from all of the tracks in order, rather than merging
+    // them into a single list first.
+    MidiEventMerger events(file.getTracks());
+    playEvents([&]() { return events.next(); }, file.getTicksPerBeat(),
+               start_location, initial_settings,
                /* allow_count_in */ false, nullptr);
     myDevice->stopAllNotes();
 }
@@ -418,6 +391,15 @@ MidiPlayer::performCountIn(const Score &score, const SystemLocation &location,
     }
 }
 
+std::optional<SystemLocation> MidiPlayer::takePlaybackPosition()
+{
+    std::optional<SystemLocation> location;
+    while (std::optional<SystemLocation> next = myPositionChanges.tryPop())
+        location = next;
+
+    return location;
+}
+
 void MidiPlayer::stopPlayback()
 {
     if (myIsPlaying)
@@ -21,19 +21,23 @@
 #include <array>
 #include <atomic>
 #include <boost/signals2/connection.hpp>
+#include <functional>
+#include <memory>
 #include <midi/midievent.h>
 #include <midi/midifile.h>
 #include <optional>
 #include <QObject>
 #include <score/generalmidi.h>
 #include <score/scorelocation.h>
+#include <score/systemlocation.h>
+#include <util/spscqueue.h>
 #include <vector>
 
+class MidiBarCache;
 class MidiFile;
 class MidiOutputDevice;
 class Score;
 class SettingsManager;
-class SystemLocation;
 
 /// Initial values for playback settings which can be updated live from the
 /// mixer, see liveChangePlayerSettings() and liveChangePlaybackSpeed().
@@ -67,13 +71,21 @@ public:
 
     void stopPlayback();
 
+    /// Returns the latest playback position, if it has changed since the
+    /// last call. This is intended to be polled from the UI thread, so that
+    /// the playback thread never waits on the UI.
+    std::optional<SystemLocation> takePlaybackPosition();
+
     static MidiFile generateSingleNote(const ConstScoreLocation &location,
                                        const SettingsManager &settings);
 
 public slots:
     void init();
+    /// Plays the score from the given location. The cache is used to avoid
+    /// regenerating the MIDI events for bars that haven't been modified.
     void playScore(const ConstScoreLocation &start_score_location,
-                   const MidiPlaybackSettings &initial_settings);
+                   const MidiPlaybackSettings &initial_settings,
+                   std::shared_ptr<MidiBarCache> cache);
     void playSingleNote(MidiFile &midi_data,
                         const ConstScoreLocation &start_location,
                         const MidiPlaybackSettings &initial_settings);
@@ -87,10 +99,6 @@ public slots:
     void liveChangePlayerSettings(int player, uint8_t max_volume, uint8_t pan);
 
 signals:
-    /// These signals are used to move the caret when a position change is
-    /// necessary.
-    void playbackSystemChanged(int system);
-    void playbackPositionChanged(int position);
     void playbackFinished();
 
     void error(const QString &msg);
@@ -107,7 +115,9 @@ private:
     void performCountIn(const Score &score,
                         const SystemLocation &location,
                         Midi::Tempo beat_duration);
-    bool playEvents(MidiFile &file, const SystemLocation &start_location,
+    /// Plays the events returned by next_event, which have delta ticks.
+    bool playEvents(const std::function<std::optional<MidiEvent>()> &next_event,
+                    int ticks_per_beat, const SystemLocation &start_location,
                     const MidiPlaybackSettings &initial_settings,
                     bool allow_count_in = false, const Score *score = nullptr);
 
@@ -124,6 +134,9 @@ private:
     /// Location where playback began.
     std::optional<ConstScoreLocation> myStartLocation;
 
+    /// Position changes during playback, for the UI to consume.
+    Util::SpscQueue<SystemLocation> myPositionChanges;
+
     /// Max volume and pan for each channel.
     std::array<std::atomic<uint8_t>, Midi::NUM_MIDI_CHANNELS_PER_PORT> myChannelMaxVolumes;
     std::array<std::atomic<uint8_t>, Midi::NUM_MIDI_CHANNELS_PER_PORT> myChannelPans;
@@ -0,0 +1,86 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "midischeduler.h"
+
+#include <thread>
+
+MidiClock::~MidiClock() = default;
+
+MidiClock &MidiClock::system()
+{
+    static MidiClock clock;
+    return clock;
+}
+
+MidiClock::Clock::time_point MidiClock::now() const
+{
+    return Clock::now();
+}
+
+void MidiClock::sleepUntil(Clock::time_point time)
+{
+    std::this_thread::sleep_until(time);
+}
+
+void MidiClock::yield()
+{
+    std::this_thread::yield();
+}
+
+MidiScheduler::MidiScheduler(int ticks_per_beat, MidiClock &clock)
+    : myClock(clock), myTicksPerBeat(ticks_per_beat), myElapsedTime(0)
+{
+    start();
+}
+
+void MidiScheduler::start()
+{
+    myStartTime = myClock.now();
+    myElapsedTime = myElapsedTime.zero();
+}
+
+MidiScheduler::Clock::time_point
+MidiScheduler::advance(int delta_ticks, Midi::Tempo beat_duration,
+                       int playback_speed)
+{
+    myElapsedTime += std::chrono::duration<double, std::micro>(
+        static_cast<double>(delta_ticks) * beat_duration.count() /
+        myTicksPerBeat * (100.0 / playback_speed));
+
+    return myStartTime +
+           std::chrono::round<Clock::duration>(myElapsedTime);
+}
+
+void MidiScheduler::waitUntil(Clock::time_point deadline)
+{
+    if (deadline - myClock.now() > SPIN_DURATION)
+        myClock.sleepUntil(deadline - SPIN_DURATION);
+
+    while (myClock.now() < deadline)
+        myClock.yield();
+}
+
+MidiScheduler::Clock::time_point
+MidiScheduler::waitForEvent(int delta_ticks, Midi::Tempo beat_duration,
+                            int playback_speed)
+{
+    const Clock::time_point deadline =
+        advance(delta_ticks, beat_duration, playback_speed);
+    waitUntil(deadline);
+    return deadline;
+}
@@ -0,0 +1,89 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUDIO_MIDISCHEDULER_H
+#define AUDIO_MIDISCHEDULER_H
+
+#include <chrono>
+#include <midi/midievent.h>
+
+/// Provides the current time and waits on behalf of a MidiScheduler. This
+/// uses the system's steady clock, but can be replaced in tests so that they
+/// don't depend on real time.
+class MidiClock
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    virtual ~MidiClock();
+
+    /// Returns a clock that uses real time.
+    static MidiClock &system();
+
+    virtual Clock::time_point now() const;
+
+    /// Sleeps until around the given time, possibly oversleeping.
+    virtual void sleepUntil(Clock::time_point time);
+
+    /// Briefly gives up the processor while spinning.
+    virtual void yield();
+};
+
+/// Computes when each event should be sent during playback.
+/// Each event's deadline is measured from the start of playback rather than
+/// from when the previous event was actually sent, so any oversleeping does
+/// not accumulate over the course of the score.
+class MidiScheduler
+{
+public:
+    using Clock = MidiClock::Clock;
+
+    /// How long to spin for before a deadline, rather than sleeping.
+    static constexpr std::chrono::microseconds SPIN_DURATION{ 500 };
+
+    explicit MidiScheduler(int ticks_per_beat,
+                           MidiClock &clock = MidiClock::system());
+
+    /// Starts the timeline at the current time, e.g. after a count-in.
+    void start();
+
+    /// Advances the timeline by the given number of ticks at the current
+    /// tempo and playback speed (percent), and returns the time at which the
+    /// next event should be sent.
+    Clock::time_point advance(int delta_ticks, Midi::Tempo beat_duration,
+                              int playback_speed);
+
+    /// Blocks until the deadline. This sleeps for most of the interval and
+    /// then spins for the remainder, since sleeping alone can overshoot by
+    /// a millisecond or more.
+    void waitUntil(Clock::time_point deadline);
+
+    /// Advances the timeline to the next event and waits until its deadline,
+    /// which is returned.
+    Clock::time_point waitForEvent(int delta_ticks, Midi::Tempo beat_duration,
+                                   int playback_speed);
+
+private:
+    MidiClock &myClock;
+    int myTicksPerBeat;
+    Clock::time_point myStartTime;
+    /// Time from the start of playback until the most recent deadline. This
+    /// is fractional so that rounding errors don't accumulate.
+    std::chrono::duration<double, std::micro> myElapsedTime;
+};
+
+#endif
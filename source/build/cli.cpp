@@ -0,0 +1,626 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// A headless tool for converting, exporting to MIDI / PDF / PNG, and
+/// validating many files at once (e.g. for processing uploaded files on a
+/// server).
+/// The results for each file are printed to stdout as a line of JSON, followed
+/// by a summary line.
+
+#include <app/appinfo.h>
+#include <app/paths.h>
+#include <app/settings.h>
+#include <app/settingsmanager.h>
+#include <app/viewoptions.h>
+#include <formats/conversionpool.h>
+#include <formats/fileformatmanager.h>
+#include <painters/layoutcache.h>
+#include <painters/scoreprinter.h>
+#include <score/binaryserialization.h>
+#include <score/score.h>
+#include <score/serialization.h>
+#include <score/utils/scorepolisher.h>
+#include <util/parallelfor.h>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFontDatabase>
+#include <QImage>
+#include <QPageSize>
+#include <QPalette>
+#include <QPdfWriter>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+#endif
+
+namespace
+{
+struct Options
+{
+    /// The format to convert the files to, if any.
+    std::optional<FileFormat> myExportFormat;
+    /// Whether to also export each file to MIDI.
+    std::optional<FileFormat> myMidiFormat;
+    /// The directory to write converted files to.
+    std::filesystem::path myOutputDir;
+    bool myExportPdf = false;
+    bool myExportPng = false;
+    /// The spacing between systems when printing.
+    int mySystemSpacing = 0;
+    bool myPolish = false;
+    bool myValidate = false;
+    int myNumJobs = 0;
+};
+
+/// A file to be processed, along with the directory that it was found in (for
+/// reproducing the directory structure in the output directory).
+struct WorkItem
+{
+    std::filesystem::path myPath;
+    std::filesystem::path myBaseDir;
+};
+
+using Clock = std::chrono::steady_clock;
+} // namespace
+
+/// Returns the current memory usage (resident set size) of the process in
+/// kilobytes. Since the files are processed in parallel, the usage while
+/// processing a file also includes the other files being processed unless
+/// running with one job.
+static std::uintmax_t
+getMemoryUsage()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return counters.WorkingSetSize / 1024;
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    {
+        return 0;
+    }
+
+    return info.resident_size / 1024;
+#else
+    // The second field is the number of resident pages.
+    std::ifstream statm("/proc/self/statm");
+    std::uintmax_t size = 0, resident = 0;
+    if (!(statm >> size >> resident))
+        return 0;
+
+    return resident * static_cast<std::uintmax_t>(sysconf(_SC_PAGESIZE)) / 1024;
+#endif
+}
+
+/// Returns the peak memory usage of the process in kilobytes.
+static std::uintmax_t
+getPeakMemoryUsage()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#ifdef __APPLE__
+    // macOS reports the size in bytes rather than kilobytes.
+    return static_cast<std::uintmax_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<std::uintmax_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+/// Calls the function and records its duration in milliseconds.
+template <typename F>
+static void
+timeStep(nlohmann::json &timings, const char *name, F f)
+{
+    const auto start = Clock::now();
+    f();
+    timings[name] =
+        std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/// Checks that the score is unchanged after saving and loading it in the .pt2
+/// and binary formats.
+static void
+validateRoundTrip(const Score &score)
+{
+    {
+        std::ostringstream output;
+        ScoreUtils::save(output, "score", score);
+
+        Score copy;
+        std::istringstream input(output.str());
+        ScoreUtils::load(input, "score", copy);
+        if (!(copy == score))
+            throw std::runtime_error("score changed after .pt2 round trip");
+    }
+
+    {
+        std::ostringstream output;
+        ScoreUtils::saveBinary(output, score);
+
+        Score copy;
+        std::istringstream input(output.str());
+        ScoreUtils::loadBinary(input, copy);
+        if (!(copy == score))
+            throw std::runtime_error("score changed after .pt2b round trip");
+    }
+}
+
+/// Returns the path to write the converted file to, using the given
+/// extension.
+static std::filesystem::path
+getOutputPath(const WorkItem &item, const Options &options,
+              const std::string &extension)
+{
+    std::filesystem::path path =
+        options.myOutputDir.empty()
+            ? item.myPath
+            : options.myOutputDir /
+                  item.myPath.lexically_relative(item.myBaseDir);
+    path.replace_extension(extension);
+    return path;
+}
+
+/// Returns the colors for printing, which match the editor's light theme.
+static QPalette
+getPrintPalette()
+{
+    QPalette palette;
+    palette.setColor(QPalette::Base, Qt::white);
+    palette.setColor(QPalette::Text, Qt::black);
+    palette.setColor(QPalette::Light, Qt::white);
+    palette.setColor(QPalette::Dark, Qt::lightGray);
+    return palette;
+}
+
+/// Prints the score to a PDF file with A4 pages.
+static void
+exportPdf(const ScorePrinter &printer, const std::filesystem::path &path)
+{
+    QPdfWriter writer(Paths::toQString(path));
+    writer.setPageSize(QPageSize(QPageSize::A4));
+    writer.setPageMargins(QMarginsF(15, 15, 15, 15), QPageLayout::Millimeter);
+    printer.print(writer);
+}
+
+/// Renders each page of the score to an A4 sized image at 150 DPI, named
+/// e.g. "song-1.png".
+static void
+exportPng(const ScorePrinter &printer, const std::filesystem::path &path)
+{
+    const QSize page_size(1240, 1754);
+    const int margin = 90;
+    const std::vector<QImage> images = printer.renderPages(
+        page_size, QMargins(margin, margin, margin, margin));
+
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        std::filesystem::path page_path = path;
+        page_path.replace_filename(path.stem().string() + "-" +
+                                   std::to_string(i + 1) + ".png");
+
+        if (!images[i].save(Paths::toQString(page_path), "PNG"))
+            throw std::runtime_error("failed to write " + page_path.string());
+    }
+}
+
+/// Imports, validates and exports a single file, and returns its statistics.
+static nlohmann::json
+processFile(const WorkItem &item, const Options &options,
+            FileFormatManager &manager, const std::filesystem::path &temp_dir)
+{
+    nlohmann::json result;
+    result["file"] = item.myPath.string();
+    result["rss_before_kb"] = getMemoryUsage();
+
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(item.myPath, ec);
+    result["size_bytes"] = ec ? 0 : size;
+
+    nlohmann::json timings = nlohmann::json::object();
+    try
+    {
+        std::optional<FileFormat> format =
+            manager.findFormat(getFormatExtension(item.myPath));
+        if (!format)
+            throw std::runtime_error("unsupported file format");
+
+        Score score;
+        timeStep(timings, "import",
+                 [&]() { manager.importFile(score, item.myPath, *format); });
+        result["systems"] = score.getSystems().size();
+
+        if (options.myPolish)
+            timeStep(timings, "polish", [&]() { ScoreUtils::polishScore(score); });
+
+        if (options.myValidate)
+            timeStep(timings, "validate", [&]() { validateRoundTrip(score); });
+
+        auto exportScore = [&](const char *name, const FileFormat &format) {
+            const auto path =
+                getOutputPath(item, options, format.primaryExtension());
+            std::filesystem::create_directories(path.parent_path());
+
+            timeStep(timings, name, [&]() {
+                manager.exportFile(score, path, temp_dir, format);
+            });
+        };
+
+        if (options.myExportFormat)
+            exportScore("convert", *options.myExportFormat);
+
+        if (options.myMidiFormat)
+            exportScore("midi", *options.myMidiFormat);
+
+        if (options.myExportPdf || options.myExportPng)
+        {
+            const ViewOptions view_options;
+            LayoutCache layout_cache;
+            std::optional<ScorePrinter> printer;
+            timeStep(timings, "layout", [&]() {
+                printer.emplace(score, view_options, layout_cache,
+                                getPrintPalette(), options.mySystemSpacing);
+            });
+
+            auto exportPages = [&](const char *name, auto export_fn) {
+                const auto path = getOutputPath(item, options, name);
+                std::filesystem::create_directories(path.parent_path());
+                timeStep(timings, name, [&]() { export_fn(*printer, path); });
+            };
+
+            if (options.myExportPdf)
+                exportPages("pdf", exportPdf);
+
+            if (options.myExportPng)
+                exportPages("png", exportPng);
+        }
+
+        result["ok"] = true;
+    }
+    catch (const std::exception &e)
+    {
+        result["ok"] = false;
+        result["error"] = e.what();
+    }
+
+    result["timings_ms"] = std::move(timings);
+    result["rss_after_kb"] = getMemoryUsage();
+    return result;
+}
+
+/// Finds the supported files from the command line arguments, searching
+/// directories recursively. If a directory can't be read, an error result is
+/// added for it and the rest of that directory is skipped.
+static std::vector<WorkItem>
+findFiles(const QStringList &args, const FileFormatManager &manager,
+          std::vector<nlohmann::json> &errors)
+{
+    std::vector<WorkItem> items;
+
+    for (const QString &arg : args)
+    {
+        const std::filesystem::path path = Paths::fromQString(arg);
+
+        std::error_code ec;
+        if (!std::filesystem::is_directory(path, ec))
+        {
+            items.push_back({ path, path.parent_path() });
+            continue;
+        }
+
+        std::filesystem::recursive_directory_iterator it(
+            path, std::filesystem::directory_options::skip_permission_denied,
+            ec);
+        for (; !ec && it != std::filesystem::recursive_directory_iterator();
+             it.increment(ec))
+        {
+            const std::filesystem::directory_entry &entry = *it;
+
+            std::error_code file_ec;
+            if (entry.is_regular_file(file_ec) &&
+                manager.extensionImportSupported(
+                    getFormatExtension(entry.path())))
+            {
+                items.push_back({ entry.path(), path });
+            }
+        }
+
+        if (ec)
+        {
+            nlohmann::json result;
+            result["file"] = path.string();
+            result["ok"] = false;
+            result["error"] = ec.message();
+            errors.push_back(std::move(result));
+        }
+    }
+
+    return items;
+}
+
+int main(int argc, char *argv[])
+{
+    // Rendering to PDF or PNG requires QtGui, so use the offscreen platform
+    // to run without a display.
+#ifndef _WIN32
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+#endif
+
+    QApplication app(argc, argv);
+    QCoreApplication::setOrganizationName(AppInfo::ORGANIZATION_NAME);
+    QCoreApplication::setApplicationName(AppInfo::APPLICATION_ID);
+    QCoreApplication::setApplicationVersion(AppInfo::APPLICATION_VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+        "Converts, exports and validates files without the user interface. "
+        "The results for each file are printed as a line of JSON."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QCommandLineOption convert_option(
+        QStringLiteral("convert"),
+        QStringLiteral("Convert each file to the format with this extension "
+                       "(e.g. pt2, pt2b, gp)."),
+        QStringLiteral("extension"));
+    const QCommandLineOption midi_option(QStringLiteral("midi"),
+                                         QStringLiteral("Export each file to MIDI."));
+    const QCommandLineOption pdf_option(QStringLiteral("pdf"),
+                                        QStringLiteral("Print each file to PDF."));
+    const QCommandLineOption png_option(
+        QStringLiteral("png"),
+        QStringLiteral("Render each page of each file to a PNG image."));
+    const QCommandLineOption output_option(
+        QStringLiteral("output"),
+        QStringLiteral("Write the exported files to this directory, rather "
+                       "than next to the original files."),
+        QStringLiteral("directory"));
+    const QCommandLineOption polish_option(
+        QStringLiteral("polish"),
+        QStringLiteral("Reformat the score before validating or exporting it."));
+    const QCommandLineOption validate_option(
+        QStringLiteral("validate"),
+        QStringLiteral("Check that each score is unchanged after a round trip "
+                       "through the .pt2 and .pt2b formats."));
+    const QCommandLineOption jobs_option(
+        QStringLiteral("jobs"),
+        QStringLiteral("The number of files to process in parallel (default: "
+                       "one per core)."),
+        QStringLiteral("count"));
+
+    parser.addOptions({ convert_option, midi_option, pdf_option, png_option,
+                        output_option, polish_option, validate_option,
+                        jobs_option });
+    parser.addPositionalArgument(
+        QStringLiteral("files"),
+        QStringLiteral("The files or directories to process."),
+        QStringLiteral("files..."));
+    parser.process(app);
+
+    // Use the default settings (e.g. for MIDI export), so that the results
+    // don't depend on the user's configuration.
+    SettingsManager settings_manager;
+    FileFormatManager manager(settings_manager);
+
+    Options options;
+    options.myExportPdf = parser.isSet(pdf_option);
+    options.myExportPng = parser.isSet(png_option);
+    options.mySystemSpacing =
+        settings_manager.getReadHandle()->get(Settings::SystemSpacing);
+    options.myPolish = parser.isSet(polish_option);
+    options.myValidate = parser.isSet(validate_option);
+
+    if (parser.isSet(jobs_option))
+    {
+        bool ok = false;
+        options.myNumJobs = parser.value(jobs_option).toInt(&ok);
+        if (!ok || options.myNumJobs <= 0)
+        {
+            std::cerr << "Invalid number of jobs: "
+                      << parser.value(jobs_option).toStdString()
+                      << "\nThe number of jobs must be a positive integer."
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (parser.isSet(output_option))
+        options.myOutputDir = Paths::fromQString(parser.value(output_option));
+
+    auto findExportFormat = [&](const std::string &extension) {
+        for (const FileFormat &format : manager.exportFormats())
+        {
+            if (format.contains(extension))
+                return format;
+        }
+
+        std::cerr << "Unsupported export format: " << extension << std::endl;
+        std::exit(EXIT_FAILURE);
+    };
+
+    if (parser.isSet(convert_option))
+    {
+        options.myExportFormat =
+            findExportFormat(parser.value(convert_option).toStdString());
+    }
+
+    if (parser.isSet(midi_option))
+        options.myMidiFormat = findExportFormat("mid");
+
+    std::vector<nlohmann::json> find_errors;
+    const std::vector<WorkItem> items =
+        findFiles(parser.positionalArguments(), manager, find_errors);
+    if (items.empty() && find_errors.empty())
+        parser.showHelp(EXIT_FAILURE);
+
+    // Refuse to overwrite the original files, e.g. when converting .pt2 files
+    // to .pt2 without an output directory.
+    std::vector<std::string> output_extensions;
+    if (options.myExportFormat)
+        output_extensions.push_back(options.myExportFormat->primaryExtension());
+    if (options.myMidiFormat)
+        output_extensions.push_back(options.myMidiFormat->primaryExtension());
+    if (options.myExportPdf)
+        output_extensions.push_back("pdf");
+    if (options.myExportPng)
+        output_extensions.push_back("png");
+
+    // Also refuse to write several inputs to the same output file (e.g.
+    // a/song.ptb and b/song.ptb with the same output directory, or song.ptb
+    // and song.gp5 in the same directory).
+    std::map<std::filesystem::path, const WorkItem *> output_paths;
+
+    for (const WorkItem &item : items)
+    {
+        for (const std::string &extension : output_extensions)
+        {
+            const auto output_path = getOutputPath(item, options, extension);
+
+            std::error_code ec;
+            if (std::filesystem::equivalent(item.myPath, output_path, ec))
+            {
+                std::cerr << "The output would overwrite the input file "
+                          << item.myPath.string()
+                          << "\nUse --output to choose another directory."
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            auto [it, inserted] = output_paths.try_emplace(
+                std::filesystem::absolute(output_path).lexically_normal(),
+                &item);
+            if (!inserted && it->second != &item)
+            {
+                std::cerr << "The input files " << it->second->myPath.string()
+                          << " and " << item.myPath.string()
+                          << " would be written to the same output file "
+                          << output_path.string() << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (options.myExportPdf || options.myExportPng)
+    {
+        QFontDatabase::addApplicationFont(
+            QStringLiteral(":fonts/emmentaler-13.otf"));
+        QFontDatabase::addApplicationFont(
+            QStringLiteral(":fonts/LiberationSans-Regular.ttf"));
+        QFontDatabase::addApplicationFont(
+            QStringLiteral(":fonts/LiberationSerif-Regular.ttf"));
+    }
+
+    const int num_workers = Util::getWorkerCount(
+        static_cast<int>(std::min<size_t>(items.size(),
+                                          std::numeric_limits<int>::max())),
+        options.myNumJobs);
+
+    const auto start_time = Clock::now();
+    std::mutex output_mutex;
+    std::atomic<int> num_failed = static_cast<int>(find_errors.size());
+    std::atomic<std::uintmax_t> num_bytes = 0;
+
+    for (const nlohmann::json &result : find_errors)
+    {
+        std::cout << result.dump(-1, ' ', false,
+                                 nlohmann::json::error_handler_t::replace)
+                  << std::endl;
+    }
+
+    // Exported files are first written to a temporary folder.
+    const std::filesystem::path temp_root =
+        std::filesystem::temp_directory_path() /
+        ("powertabeditor-cli-" +
+         std::to_string(QCoreApplication::applicationPid()));
+
+    runConversionPool<const WorkItem *>(
+        num_workers, temp_root, settings_manager,
+        [&](Util::WorkQueue<const WorkItem *> &queue) {
+            for (const WorkItem &item : items)
+                queue.push(&item);
+        },
+        [&](FileFormatManager &worker_manager, const WorkItem *item,
+            const std::filesystem::path &temp_dir) {
+            nlohmann::json result =
+                processFile(*item, options, worker_manager, temp_dir);
+
+            if (!result["ok"].get<bool>())
+                ++num_failed;
+            num_bytes += result["size_bytes"].get<std::uintmax_t>();
+
+            // Replace any invalid UTF-8 in paths rather than throwing.
+            std::lock_guard lock(output_mutex);
+            std::cout << result.dump(-1, ' ', false,
+                                     nlohmann::json::error_handler_t::replace)
+                      << std::endl;
+        });
+
+    const double seconds =
+        std::chrono::duration<double>(Clock::now() - start_time).count();
+
+    nlohmann::json summary;
+    summary["files"] = items.size() + find_errors.size();
+    summary["failed"] = num_failed.load();
+    summary["jobs"] = num_workers;
+    summary["seconds"] = seconds;
+    summary["files_per_second"] = items.size() / std::max(seconds, 1e-6);
+    summary["mb_per_second"] =
+        num_bytes / (1024.0 * 1024.0) / std::max(seconds, 1e-6);
+    summary["peak_memory_kb"] = getPeakMemoryUsage();
+    std::cout << nlohmann::json{ { "summary", summary } }.dump() << std::endl;
+
+    return num_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
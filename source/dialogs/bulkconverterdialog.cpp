@@ -21,35 +21,47 @@
 #include "formats/powertab/common.h"
 
 #include <app/paths.h>
+#include <formats/conversionpool.h>
 #include <score/score.h>
+#include <util/parallelfor.h>
 
+#include <QCoreApplication>
 #include <QFileDialog>
 #include <QDebug>
 #include <QThread>
 
-/// Returns the file extension without the leading '.'
-static std::string
-getExtension(const std::filesystem::path &path)
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+namespace
 {
-    std::string extension = path.extension().string();
-    extension.erase(std::remove(extension.begin(), extension.end(), '.'),
-                    extension.end());
-    return extension;
-}
+/// A file to be converted by one of the worker threads.
+struct ConversionItem
+{
+    std::filesystem::path mySrc;
+    std::filesystem::path myDst;
+};
+} // namespace
 
 static std::optional<std::string>
 convertFile(const std::filesystem::path &src, const std::filesystem::path &dst,
-            const FileFormat &export_format,
-            std::unique_ptr<FileFormatManager> &ffm)
+            const std::filesystem::path &temp_dir,
+            const FileFormat &export_format, FileFormatManager &ffm)
 {
-    std::optional<FileFormat> format = ffm->findFormat(getExtension(src));
+    std::optional<FileFormat> format = ffm.findFormat(getFormatExtension(src));
     // Should already have a valid import extension if this method is called.
     assert(format);
 
+    std::error_code ec;
+    std::filesystem::create_directories(dst.parent_path(), ec);
+    if (ec)
+        return "could not create directory: " + dst.parent_path().string();
+
     Score score;
     try
     {
-        ffm->importFile(score, src, *format);
+        ffm.importFile(score, src, *format);
     }
     catch (const std::exception &)
     {
@@ -58,7 +70,7 @@ convertFile(const std::filesystem::path &src, const std::filesystem::path &dst,
 
     try
     {
-        ffm->exportFile(score, dst, Paths::getBackupDir(), export_format);
+        ffm.exportFile(score, dst, temp_dir, export_format);
     }
     catch (const std::exception &)
     {
@@ -71,14 +83,16 @@ convertFile(const std::filesystem::path &src, const std::filesystem::path &dst,
 BulkConverterWorker::BulkConverterWorker(
     std::filesystem::path &source, std::filesystem::path &destination,
     bool dryRun, const FileFormat &export_format,
-    std::unique_ptr<FileFormatManager> &fileFormatManager)
+    std::unique_ptr<FileFormatManager> &fileFormatManager,
+    const SettingsManager &settingsManager)
     : QObject(),
       mySrc(source),
       myDst(destination),
       myDryRun(dryRun),
       myFileCount(0),
       myExportFormat(export_format),
-      myFileFormatManager(fileFormatManager)
+      myFileFormatManager(fileFormatManager),
+      mySettingsManager(settingsManager)
 {
 }
 
@@ -88,64 +102,123 @@ BulkConverterWorker::~BulkConverterWorker()
 
 void BulkConverterWorker::walkAndConvert()
 {
-    std::vector<std::filesystem::path> children;
+    using Clock = std::chrono::steady_clock;
+    const auto start_time = Clock::now();
 
-    children.emplace_back(mySrc);
+    // The directory walk feeds a pool of workers, which convert the files in
+    // parallel. In a dry run, the files are only counted.
+    const int num_workers =
+        myDryRun ? 0 : Util::getWorkerCount(std::numeric_limits<int>::max());
+    std::atomic<int> num_converted = 0;
+    std::atomic<std::uintmax_t> num_bytes = 0;
 
-    do {
-        std::filesystem::path p = children.back();
-        children.pop_back();
+    // The exported files are written to a temporary folder first. Include the
+    // process id in case another instance is also running the converter.
+    const std::filesystem::path temp_root =
+        Paths::getBackupDir() /
+        ("bulk_converter_" +
+         std::to_string(QCoreApplication::applicationPid()));
 
-        if (!std::filesystem::is_directory(p)) continue;
+    auto walk_directory = [&](Util::WorkQueue<ConversionItem> &queue) {
+        std::vector<std::filesystem::path> children;
 
-        for(auto& entry : std::filesystem::directory_iterator(p))
-        {
-            if (std::filesystem::is_directory(entry)) {
-               children.emplace_back(entry);
-               continue;
-            }
+        children.emplace_back(mySrc);
 
-            const bool isRegularFile = std::filesystem::is_regular_file(entry);
-            std::string extension = getExtension(entry.path());
-            const bool isSupportedFormat = myFileFormatManager->extensionImportSupported(extension);
+        do {
+            std::filesystem::path p = children.back();
+            children.pop_back();
 
-            if (!(isRegularFile && isSupportedFormat)) {
-                QString errorMsg = QString::fromStdString(std::string("ignoring unsupported extension: ") + extension);
-                emit message(errorMsg);
-                continue;
-            }
+            if (!std::filesystem::is_directory(p)) continue;
 
-            myFileCount++;
+            for(auto& entry : std::filesystem::directory_iterator(p))
+            {
+                if (std::filesystem::is_directory(entry)) {
+                   children.emplace_back(entry);
+                   continue;
+                }
 
-            auto toPath = myDst / entry.path().lexically_relative(mySrc);
-            toPath.replace_extension(myExportFormat.primaryExtension());
+                const bool isRegularFile = std::filesystem::is_regular_file(entry);
+                std::string extension = getFormatExtension(entry.path());
+                const bool isSupportedFormat = myFileFormatManager->extensionImportSupported(extension);
 
-            if (myDryRun) continue;
+                if (!(isRegularFile && isSupportedFormat)) {
+                    QString errorMsg = QString::fromStdString(std::string("ignoring unsupported extension: ") + extension);
+                    emit message(errorMsg);
+                    continue;
+                }
 
-            auto destBaseDir = toPath.parent_path();
-            if (!std::filesystem::exists(destBaseDir))
-                std::filesystem::create_directories(destBaseDir);
+                myFileCount++;
 
-            std::optional<std::string> error =
-                convertFile(entry, toPath, myExportFormat, myFileFormatManager);
-            if (error != std::nullopt) {
-                QString err = QString::fromStdString(error.value());
-                emit message("error processing file: " + err);
-            }
+                auto toPath = myDst / entry.path().lexically_relative(mySrc);
+                toPath.replace_extension(myExportFormat.primaryExtension());
+
+                if (myDryRun) continue;
 
-            emit progress((int) myFileCount);
+                queue.push({ entry.path(), std::move(toPath) });
+            }
+        } while (!children.empty());
+    };
+
+    auto convert_file = [&](FileFormatManager &manager,
+                            const ConversionItem &item,
+                            const std::filesystem::path &temp_dir) {
+        const auto file_start_time = Clock::now();
+        std::optional<std::string> error = convertFile(
+            item.mySrc, item.myDst, temp_dir, myExportFormat, manager);
+        const auto file_time =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                Clock::now() - file_start_time);
+
+        if (error != std::nullopt) {
+            QString err = QString::fromStdString(error.value());
+            emit message("error processing file: " + err);
+        }
+        else {
+            std::error_code ec;
+            const std::uintmax_t size =
+                std::filesystem::file_size(item.mySrc, ec);
+            if (!ec)
+                num_bytes += size;
+
+            emit message(QString("converted %1 (%2 ms)")
+                             .arg(Paths::toQString(item.mySrc))
+                             .arg(file_time.count()));
         }
-    } while (!children.empty());
+
+        emit progress(++num_converted);
+    };
+
+    runConversionPool<ConversionItem>(num_workers, temp_root,
+                                      mySettingsManager, walk_directory,
+                                      convert_file);
+
+    if (!myDryRun)
+    {
+        const double seconds =
+            std::chrono::duration<double>(Clock::now() - start_time).count();
+        const double megabytes = num_bytes / (1024.0 * 1024.0);
+
+        emit message(
+            QString("converted %1 files in %2 s using %3 threads "
+                    "(%4 files/s, %5 MB/s)")
+                .arg(num_converted.load())
+                .arg(seconds, 0, 'f', 1)
+                .arg(num_workers)
+                .arg(num_converted / std::max(seconds, 1e-3), 0, 'f', 1)
+                .arg(megabytes / std::max(seconds, 1e-3), 0, 'f', 2));
+    }
 
     emit message("DONE!");
     emit done();
 }
 
 BulkConverterDialog::BulkConverterDialog(QWidget *parent,
-                                         std::unique_ptr<FileFormatManager>& manager)
+                                         std::unique_ptr<FileFormatManager>& manager,
+                                         const SettingsManager &settingsManager)
   : QDialog(parent), ui(new Ui::BulkConverterDialog),
     myBulkWorkerThread(nullptr), myBulkConverterWorker(nullptr),
-    myFileFormatManager(manager)
+    myFileFormatManager(manager),
+    mySettingsManager(settingsManager)
 {
     ui->setupUi(this);
 
@@ -207,7 +280,7 @@ void BulkConverterDialog::convert()
     {
         // set default max.
         BulkConverterWorker bcw(src, dst, true, export_format,
-                                myFileFormatManager);
+                                myFileFormatManager, mySettingsManager);
         bcw.walkAndConvert();
         const std::size_t fileCountToConvert = bcw.fileCount();
         ui->progressBar->setMaximum((int) fileCountToConvert);
@@ -219,7 +292,8 @@ void BulkConverterDialog::convert()
     // current state of bulk conversion.
     myBulkWorkerThread = new QThread;
     myBulkConverterWorker = new BulkConverterWorker(
-        src, dst, false, export_format, myFileFormatManager);
+        src, dst, false, export_format, myFileFormatManager,
+        mySettingsManager);
     myBulkConverterWorker->moveToThread(myBulkWorkerThread);
 
     connect(myBulkWorkerThread, &QThread::started,
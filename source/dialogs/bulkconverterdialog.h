@@ -33,6 +33,8 @@ namespace Ui {
     class BulkConverterDialog;
 }
 
+class SettingsManager;
+
 class BulkConverterWorker : public QObject
 {
     Q_OBJECT
@@ -42,13 +44,16 @@ public:
                                  std::filesystem::path& destination,
                                  bool dryRun,
                                  const FileFormat &export_format,
-                                 std::unique_ptr<FileFormatManager>& fileFormatManager);
+                                 std::unique_ptr<FileFormatManager>& fileFormatManager,
+                                 const SettingsManager &settingsManager);
     ~BulkConverterWorker();
 
     inline void setFileCount(std::size_t f) { myFileCount = f; }
     inline std::size_t fileCount() { return myFileCount; }
 
 public slots:
+    /// Walks the source directory, and converts each supported file using a
+    /// pool of worker threads (unless this is a dry run).
     void walkAndConvert();
 
 signals:
@@ -63,6 +68,7 @@ private:
     std::size_t myFileCount;
     FileFormat myExportFormat;
     std::unique_ptr<FileFormatManager>& myFileFormatManager;
+    const SettingsManager &mySettingsManager;
 };
 
 class BulkConverterDialog : public QDialog {
@@ -70,7 +76,8 @@ class BulkConverterDialog : public QDialog {
 
 public:
     explicit BulkConverterDialog(QWidget *parent,
-                                 std::unique_ptr<FileFormatManager>& fileFormatManager);
+                                 std::unique_ptr<FileFormatManager>& fileFormatManager,
+                                 const SettingsManager &settingsManager);
     ~BulkConverterDialog();
 
 public slots:
@@ -89,6 +96,7 @@ private:
     QThread* myBulkWorkerThread;
     BulkConverterWorker* myBulkConverterWorker;
     std::unique_ptr<FileFormatManager>& myFileFormatManager;
+    const SettingsManager &mySettingsManager;
 };
 
 #endif
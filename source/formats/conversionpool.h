@@ -0,0 +1,61 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FORMATS_CONVERSIONPOOL_H
+#define FORMATS_CONVERSIONPOOL_H
+
+#include "fileformatmanager.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <util/workerpool.h>
+
+class SettingsManager;
+
+/// Returns the file extension without the leading '.', e.g. for
+/// FileFormatManager::findFormat().
+inline std::string
+getFormatExtension(const std::filesystem::path &path)
+{
+    std::string extension = path.extension().string();
+    if (!extension.empty())
+        extension.erase(0, 1);
+    return extension;
+}
+
+/// Converts files on a pool of worker threads (see Util::runWorkerPool()).
+/// The importers and exporters aren't thread-safe, so each worker has its own
+/// FileFormatManager, and calls convert(manager, item, temp_dir) for each item
+/// that the producer adds to the queue.
+template <typename T, typename Producer, typename Convert>
+void
+runConversionPool(int num_workers, const std::filesystem::path &temp_root,
+                  const SettingsManager &settings_manager, Producer producer,
+                  Convert convert)
+{
+    Util::runWorkerPool<T>(
+        num_workers, temp_root, producer,
+        [&](Util::WorkQueue<T> &queue, const std::filesystem::path &temp_dir) {
+            FileFormatManager manager(settings_manager);
+
+            while (std::optional<T> item = queue.pop())
+                convert(manager, *item, temp_dir);
+        });
+}
+
+#endif
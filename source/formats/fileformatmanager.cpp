@@ -23,6 +23,8 @@
 #include <formats/gpx/gpximporter.h>
 #include <formats/guitar_pro/guitarproimporter.h>
 #include <formats/midi/midiexporter.h>
+#include <formats/powertab/powertabbinaryexporter.h>
+#include <formats/powertab/powertabbinaryimporter.h>
 #include <formats/powertab/powertabexporter.h>
 #include <formats/powertab/powertabimporter.h>
 #include <formats/powertab_old/powertaboldimporter.h>
@@ -30,12 +32,14 @@
 FileFormatManager::FileFormatManager(const SettingsManager &settings_manager)
 {
     myImporters.emplace_back(std::make_unique<PowerTabImporter>());
+    myImporters.emplace_back(std::make_unique<PowerTabBinaryImporter>());
     myImporters.emplace_back(std::make_unique<PowerTabOldImporter>());
     myImporters.emplace_back(std::make_unique<GuitarProImporter>());
     myImporters.emplace_back(std::make_unique<GpxImporter>());
     myImporters.emplace_back(std::make_unique<Gp7Importer>());
 
     myExporters.emplace_back(std::make_unique<PowerTabExporter>());
+    myExporters.emplace_back(std::make_unique<PowerTabBinaryExporter>());
     myExporters.emplace_back(std::make_unique<Gp7Exporter>());
     myExporters.emplace_back(std::make_unique<MidiExporter>(settings_manager));
 }
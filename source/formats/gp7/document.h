@@ -21,12 +21,15 @@
 #include <bitset>
 #include <boost/rational.hpp>
 #include <boost/functional/hash.hpp>
+#include <map>
 #include <optional>
 #include <pugixml.hpp>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <util/enumtostring_fwd.h>
+#include <utility>
 #include <vector>
 
 namespace Gp7
@@ -423,6 +426,154 @@ struct Note
     std::optional<Bend> myBend;
 };
 
+/// Stores the bars, voices, etc of a document by their ids.
+/// The ids are normally assigned sequentially from zero, so they are used as
+/// indices into a contiguous array. Any negative or unusually large ids (e.g.
+/// from a malformed file) are stored separately in a map.
+template <typename T>
+class IdTable
+{
+public:
+    /// Inserts the item, unless there is already an item with the same id.
+    /// Returns whether the item was inserted.
+    bool emplace(int id, T item)
+    {
+        if (id >= 0 && static_cast<size_t>(id) >= myItems.size() &&
+            static_cast<size_t>(id) <= 2 * myCount + theMinDenseSize)
+        {
+            growDense(static_cast<size_t>(id) + 1);
+        }
+
+        if (id >= 0 && static_cast<size_t>(id) < myItems.size())
+        {
+            std::optional<T> &slot = myItems[id];
+            if (slot)
+                return false;
+
+            slot = std::move(item);
+        }
+        else if (!mySparseItems.emplace(id, std::move(item)).second)
+            return false;
+
+        ++myCount;
+        return true;
+    }
+
+    /// Returns the item with the given id, or throws std::out_of_range.
+    const T &at(int id) const
+    {
+        if (id >= 0 && static_cast<size_t>(id) < myItems.size())
+        {
+            if (const std::optional<T> &slot = myItems[id])
+                return *slot;
+
+            throw std::out_of_range("Invalid id");
+        }
+
+        return mySparseItems.at(id);
+    }
+
+    T &at(int id)
+    {
+        return const_cast<T &>(std::as_const(*this).at(id));
+    }
+
+    /// Returns the number of items.
+    size_t size() const
+    {
+        return myCount;
+    }
+
+    class const_iterator
+    {
+    public:
+        const_iterator(const IdTable &table, size_t index,
+                       typename std::map<int, T>::const_iterator sparse_it)
+            : myTable(&table), myIndex(index), mySparseIt(sparse_it)
+        {
+            skipEmpty();
+        }
+
+        std::pair<int, const T &> operator*() const
+        {
+            if (isSparse())
+                return { mySparseIt->first, mySparseIt->second };
+
+            return { static_cast<int>(myIndex), *myTable->myItems[myIndex] };
+        }
+
+        const_iterator &operator++()
+        {
+            if (isSparse())
+                ++mySparseIt;
+            else
+                ++myIndex;
+
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const = default;
+
+    private:
+        /// Negative ids are visited before the array, and large ids after it.
+        bool isSparse() const
+        {
+            return mySparseIt != myTable->mySparseItems.end() &&
+                   (mySparseIt->first < 0 ||
+                    myIndex == myTable->myItems.size());
+        }
+
+        void skipEmpty()
+        {
+            while (!isSparse() && myIndex < myTable->myItems.size() &&
+                   !myTable->myItems[myIndex])
+            {
+                ++myIndex;
+            }
+        }
+
+        const IdTable *myTable;
+        size_t myIndex;
+        typename std::map<int, T>::const_iterator mySparseIt;
+    };
+
+    /// Iterates over the (id, item) pairs in order of their ids.
+    const_iterator begin() const
+    {
+        return const_iterator(*this, 0, mySparseItems.begin());
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(*this, myItems.size(), mySparseItems.end());
+    }
+
+private:
+    /// Ids below this are always stored in the array. Beyond this, the array
+    /// only grows if it would be at least half full.
+    static constexpr size_t theMinDenseSize = 1024;
+
+    void growDense(size_t size)
+    {
+        const size_t old_size = myItems.size();
+        myItems.resize(size);
+
+        // Move over any items that are now within the array's range.
+        auto it = mySparseItems.lower_bound(static_cast<int>(old_size));
+        while (it != mySparseItems.end() &&
+               static_cast<size_t>(it->first) < size)
+        {
+            myItems[it->first] = std::move(it->second);
+            it = mySparseItems.erase(it);
+        }
+    }
+
+    std::vector<std::optional<T>> myItems;
+    std::map<int, T> mySparseItems;
+    size_t myCount = 0;
+};
+
 /// Container for a Guitar Pro 7 document.
 struct Document
 {
@@ -435,11 +586,11 @@ struct Document
     ScoreInfo myScoreInfo;
     std::vector<Track> myTracks;
     std::vector<MasterBar> myMasterBars;
-    std::unordered_map<int, Bar> myBars;
-    std::unordered_map<int, Voice> myVoices;
-    std::unordered_map<int, Beat> myBeats;
-    std::unordered_map<int, Note> myNotes;
-    std::unordered_map<int, Rhythm> myRhythms;
+    IdTable<Bar> myBars;
+    IdTable<Voice> myVoices;
+    IdTable<Beat> myBeats;
+    IdTable<Note> myNotes;
+    IdTable<Rhythm> myRhythms;
 };
 
 /// Parses the score.gpif XML file.
@@ -20,10 +20,12 @@
 #include <formats/fileformat.h>
 #include <score/generalmidi.h>
 
-#include <boost/algorithm/string/split.hpp>
-#include <string>
-
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <iostream>
+#include <string>
+#include <string_view>
 
 bool
 Gp7::MasterBar::TimeSignature::operator==(const TimeSignature &other) const
@@ -50,26 +52,43 @@ Gp7::MasterBar::KeySignature::operator!=(const KeySignature &other) const
     return !operator==(other);
 }
 
-static std::vector<std::string>
-splitString(std::string input, char separator = ' ')
+/// Parses an integer, ignoring any leading whitespace or trailing characters
+/// in the same way as std::stoi().
+static int
+parseInt(std::string_view text)
 {
-    if (input.empty())
-        return {};
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text[0])))
+        text.remove_prefix(1);
 
-    std::vector<std::string> output;
-    boost::algorithm::split(output, input,
-                            [=](char c) { return c == separator; });
-    return output;
+    int value = 0;
+    auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc())
+        throw FileFormatException("Invalid integer: " + std::string(text));
+
+    return value;
 }
 
+/// Parses a list of integers, such as "0 1 2" or "4/4".
 static std::vector<int>
-toIntList(const std::vector<std::string> &input)
+parseIntList(std::string_view input, char separator = ' ')
 {
     std::vector<int> output;
-    output.reserve(input.size());
+    if (input.empty())
+        return output;
+
+    output.reserve(std::count(input.begin(), input.end(), separator) + 1);
 
-    for (auto &&val : input)
-        output.push_back(std::stoi(val));
+    size_t start = 0;
+    while (start <= input.size())
+    {
+        size_t end = input.find(separator, start);
+        if (end == std::string_view::npos)
+            end = input.size();
+
+        output.push_back(parseInt(input.substr(start, end - start)));
+        start = end + 1;
+    }
 
     return output;
 }
@@ -96,7 +115,7 @@ parseScoreInfo(const pugi::xml_node &node)
     // Skipping ScoreSystemsDefaultLayout, ScoreZoomPolicy,
     // ScoreZoom, MultiVoice.
     info.myScoreSystemsLayout =
-        toIntList(splitString(node.child_value("ScoreSystemsLayout")));
+        parseIntList(node.child_value("ScoreSystemsLayout"));
 
     return info;
 }
@@ -116,13 +135,12 @@ parseTempoChanges(const pugi::xml_node &master_track,
         change.myIsVisible = node.child("Visible").text().as_bool(true);
 
         // There should be space-separated string such as "120 2".
-        std::vector<std::string> values =
-            splitString(node.child_value("Value"));
+        const std::vector<int> values = parseIntList(node.child_value("Value"));
         if (values.size() != 2)
             throw FileFormatException("Invalid tempo change values.");
 
-        change.myBeatsPerMinute = std::stoi(values[0]);
-        switch (std::stoi(values[1]))
+        change.myBeatsPerMinute = values[0];
+        switch (values[1])
         {
             using BeatType = Gp7::TempoChange::BeatType;
             case 1:
@@ -269,8 +287,7 @@ parseStaff(const pugi::xml_node &node, Gp7::Track &track)
     // of pitches.
     auto tuning_property =
         properties.find_child_by_attribute("Property", "name", "Tuning");
-    staff.myTuning =
-        toIntList(splitString(tuning_property.child_value("Pitches")));
+    staff.myTuning = parseIntList(tuning_property.child_value("Pitches"));
 
     if (auto diagram_property =
             properties.find_child_by_attribute("Property", "name", "DiagramCollection"))
@@ -295,8 +312,7 @@ parseTracks(const pugi::xml_node &tracks_node, Gp7::Version version)
     {
         Gp7::Track track;
         track.myName = node.child_value("Name");
-        track.mySystemsLayout =
-            toIntList(splitString(node.child_value("SystemsLayout")));
+        track.mySystemsLayout = parseIntList(node.child_value("SystemsLayout"));
 
         // Many fields related to RSE are skipped here.
 
@@ -350,7 +366,7 @@ parseMasterBars(const pugi::xml_node &master_bars_node)
     {
         Gp7::MasterBar master_bar;
 
-        master_bar.myBarIds = toIntList(splitString(node.child_value("Bars")));
+        master_bar.myBarIds = parseIntList(node.child_value("Bars"));
 
         auto section_node = node.child("Section");
         if (section_node)
@@ -378,11 +394,10 @@ parseMasterBars(const pugi::xml_node &master_bars_node)
         }
 
         master_bar.myAlternateEndings =
-            toIntList(splitString(node.child_value("AlternateEndings")));
+            parseIntList(node.child_value("AlternateEndings"));
 
         // The time signature should be a string like 12/8.
-        std::vector<int> time_sig =
-            toIntList(splitString(node.child_value("Time"), '/'));
+        std::vector<int> time_sig = parseIntList(node.child_value("Time"), '/');
         if (time_sig.size() != 2)
             throw FileFormatException("Unexpected time signature value");
 
@@ -403,7 +418,7 @@ parseMasterBars(const pugi::xml_node &master_bars_node)
              node.child("Fermatas").children("Fermata"))
         {
             std::vector<int> offset =
-                toIntList(splitString(fermata.child_value("Offset"), '/'));
+                parseIntList(fermata.child_value("Offset"), '/');
             if (offset.size() != 2)
                 throw FileFormatException("Unexpected fermata offset.");
 
@@ -450,14 +465,14 @@ parseMasterBars(const pugi::xml_node &master_bars_node)
     return master_bars;
 }
 
-static std::unordered_map<int, Gp7::Bar>
+static Gp7::IdTable<Gp7::Bar>
 parseBars(const pugi::xml_node &bars_node)
 {
-    std::unordered_map<int, Gp7::Bar> bars;
+    Gp7::IdTable<Gp7::Bar> bars;
     for (const pugi::xml_node &node : bars_node.children("Bar"))
     {
         Gp7::Bar bar;
-        bar.myVoiceIds = toIntList(splitString(node.child_value("Voices")));
+        bar.myVoiceIds = parseIntList(node.child_value("Voices"));
 
         std::string clef_name = node.child_value("Clef");
         if (auto clef_type = Util::toEnum<Gp7::Bar::ClefType>(clef_name))
@@ -468,36 +483,36 @@ parseBars(const pugi::xml_node &bars_node)
         // TODO - import the 'Ottavia' key if the clef has 8va, etc
 
         const int id = node.attribute("id").as_int();
-        bars.emplace(id, bar);
+        bars.emplace(id, std::move(bar));
     }
 
     return bars;
 }
 
-static std::unordered_map<int, Gp7::Voice>
+static Gp7::IdTable<Gp7::Voice>
 parseVoices(const pugi::xml_node &voices_node)
 {
-    std::unordered_map<int, Gp7::Voice> voices;
+    Gp7::IdTable<Gp7::Voice> voices;
     for (const pugi::xml_node &node : voices_node.children("Voice"))
     {
         Gp7::Voice voice;
-        voice.myBeatIds = toIntList(splitString(node.child_value("Beats")));
+        voice.myBeatIds = parseIntList(node.child_value("Beats"));
         const int id = node.attribute("id").as_int();
-        voices.emplace(id, voice);
+        voices.emplace(id, std::move(voice));
     }
 
     return voices;
 }
 
-static std::unordered_map<int, Gp7::Beat>
+static Gp7::IdTable<Gp7::Beat>
 parseBeats(const pugi::xml_node &beats_node, Gp7::Version version)
 {
-    std::unordered_map<int, Gp7::Beat> beats;
+    Gp7::IdTable<Gp7::Beat> beats;
     for (const pugi::xml_node &node : beats_node.children("Beat"))
     {
         Gp7::Beat beat;
         beat.myRhythmId = node.child("Rhythm").attribute("ref").as_int();
-        beat.myNoteIds = toIntList(splitString(node.child_value("Notes")));
+        beat.myNoteIds = parseIntList(node.child_value("Notes"));
 
         if (auto chord_id = node.child("Chord"))
             beat.myChordId = chord_id.text().as_int(-1);
@@ -603,16 +618,16 @@ parseBeats(const pugi::xml_node &beats_node, Gp7::Version version)
             beat.myWhammy = whammy;
 
         const int id = node.attribute("id").as_int();
-        beats.emplace(id, beat);
+        beats.emplace(id, std::move(beat));
     }
 
     return beats;
 }
 
-static std::unordered_map<int, Gp7::Note>
+static Gp7::IdTable<Gp7::Note>
 parseNotes(const pugi::xml_node &notes_node)
 {
-    std::unordered_map<int, Gp7::Note> notes;
+    Gp7::IdTable<Gp7::Note> notes;
     for (const pugi::xml_node &node : notes_node.children("Note"))
     {
         Gp7::Note note;
@@ -724,13 +739,13 @@ parseNotes(const pugi::xml_node &notes_node)
         }
 
         const int id = node.attribute("id").as_int();
-        notes.emplace(id, note);
+        notes.emplace(id, std::move(note));
     }
 
     return notes;
 }
 
-static std::unordered_map<int, Gp7::Rhythm>
+static Gp7::IdTable<Gp7::Rhythm>
 parseRhythms(const pugi::xml_node &rhythms_node)
 {
     static const std::unordered_map<std::string, int> theNoteValuesMap = {
@@ -738,7 +753,7 @@ parseRhythms(const pugi::xml_node &rhythms_node)
         { "16th", 16 }, { "32nd", 32 }, { "64th", 64 }
     };
 
-    std::unordered_map<int, Gp7::Rhythm> rhythms;
+    Gp7::IdTable<Gp7::Rhythm> rhythms;
     for (const pugi::xml_node &node : rhythms_node.children("Rhythm"))
     {
         Gp7::Rhythm rhythm;
@@ -767,7 +782,7 @@ parseRhythms(const pugi::xml_node &rhythms_node)
         }
 
         const int id = node.attribute("id").as_int();
-        rhythms.emplace(id, rhythm);
+        rhythms.emplace(id, std::move(rhythm));
     }
 
     return rhythms;
@@ -777,7 +792,7 @@ void
 Gp7::Document::addBar(MasterBar &master_bar, Bar bar)
 {
     const int bar_id = static_cast<int>(myBars.size());
-    myBars[bar_id] = std::move(bar);
+    myBars.emplace(bar_id, std::move(bar));
     master_bar.myBarIds.push_back(bar_id);
 }
 
@@ -785,7 +800,7 @@ void
 Gp7::Document::addVoice(Bar &bar, Voice voice)
 {
     const int voice_id = static_cast<int>(myVoices.size());
-    myVoices[voice_id] = std::move(voice);
+    myVoices.emplace(voice_id, std::move(voice));
     bar.myVoiceIds.push_back(voice_id);
 }
 
@@ -793,7 +808,7 @@ void
 Gp7::Document::addBeat(Voice &voice, Beat beat)
 {
     const int beat_id = static_cast<int>(myBeats.size());
-    myBeats[beat_id] = std::move(beat);
+    myBeats.emplace(beat_id, std::move(beat));
     voice.myBeatIds.push_back(beat_id);
 }
 
@@ -801,7 +816,7 @@ void
 Gp7::Document::addNote(Beat &beat, Note note)
 {
     const int note_id = static_cast<int>(myNotes.size());
-    myNotes[note_id] = std::move(note);
+    myNotes.emplace(note_id, std::move(note));
     beat.myNoteIds.push_back(note_id);
 }
 
@@ -810,7 +825,7 @@ Gp7::Document::addRhythm(Beat &beat, Rhythm rhythm)
 {
     // TODO - consolidate identical rhythms?
     const int rhythm_id = static_cast<int>(myRhythms.size());
-    myRhythms[rhythm_id] = std::move(rhythm);
+    myRhythms.emplace(rhythm_id, std::move(rhythm));
     beat.myRhythmId = rhythm_id;
 }
 
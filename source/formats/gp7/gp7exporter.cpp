@@ -22,6 +22,7 @@
 #include "document.h"
 
 #include <memory>
+#include <vector>
 #include <zlib.h>
 #include <minizip/zip.h>
 #ifdef _WIN32
@@ -95,28 +96,64 @@ struct ZipFileEntry
     zipFile myFile;
 };
 
+/// Writes data to the current entry in the zip file.
+static void
+writeToZip(zipFile file, const void *data, size_t size)
+{
+    if (zipWriteInFileInZip(file, data, static_cast<unsigned int>(size)) !=
+        ZIP_OK)
+    {
+        throw FileFormatException("Failed to write to zip file.");
+    }
+}
+
 static void
 writeVersionInfo(zipFile file)
 {
     ZipFileEntry entry(file, "VERSION");
 
     const std::string contents = "7.0";
-    zipWriteInFileInZip(file, contents.data(), contents.size());
+    writeToZip(file, contents.data(), contents.size());
 }
 
 /// pugi::xml_writer implementation for writing chunks to a zip entry.
+/// pugixml writes the document in small chunks, so these are collected into
+/// larger blocks to reduce the number of calls to the compressor.
 struct zip_entry_writer : public pugi::xml_writer
 {
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
     zip_entry_writer(zipFile file) : myFile(file)
     {
+        myBuffer.reserve(BLOCK_SIZE);
     }
 
     void write(const void *data, size_t size) override
     {
-        zipWriteInFileInZip(myFile, data, size);
+        if (myBuffer.size() + size > BLOCK_SIZE)
+            flush();
+
+        if (size >= BLOCK_SIZE)
+            writeToZip(myFile, data, size);
+        else
+        {
+            auto bytes = static_cast<const char *>(data);
+            myBuffer.insert(myBuffer.end(), bytes, bytes + size);
+        }
+    }
+
+    /// Writes any remaining data to the zip entry.
+    void flush()
+    {
+        if (!myBuffer.empty())
+        {
+            writeToZip(myFile, myBuffer.data(), myBuffer.size());
+            myBuffer.clear();
+        }
     }
 
     zipFile myFile;
+    std::vector<char> myBuffer;
 };
 
 static void
@@ -129,6 +166,7 @@ writeScore(zipFile file, const Score &score)
 
     zip_entry_writer writer(file);
     xml_doc.save(writer);
+    writer.flush();
 }
 
 } // namespace
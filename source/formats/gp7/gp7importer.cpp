@@ -27,7 +27,10 @@
 
 #include <pugixml.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <formats/fileformat.h>
+#include <limits>
 #include <score/score.h>
 #include <util/scopeexit.h>
 
@@ -78,6 +81,11 @@ UnzFileHandle openZipFile(const std::filesystem::path &filename)
     return zip_file;
 }
 
+/// The largest possible compression ratio for the deflate algorithm.
+constexpr uint64_t theMaxCompressionRatio = 1032;
+/// The largest file that will be loaded from an archive.
+constexpr uint64_t theMaxFileSize = uint64_t(1) << 30;
+
 /// Loads a file from the provided zip archive.
 std::vector<std::byte> loadFileFromZip(unzFile zip_file, const char *name)
 {
@@ -93,34 +101,45 @@ std::vector<std::byte> loadFileFromZip(unzFile zip_file, const char *name)
             throw FileFormatException("Failed to close file.");
     });
 
-    // Read the file contents, block by block.
-    std::vector<std::byte> buffer;
-    while (true)
+    // The uncompressed size is stored in the archive, so the buffer can be
+    // allocated up front.
+    unz_file_info64 file_info;
+    if (unzGetCurrentFileInfo64(zip_file, &file_info, nullptr, 0, nullptr, 0,
+                                nullptr, 0) != UNZ_OK)
+    {
+        throw FileFormatException("Failed to read file info.");
+    }
+
+    // The size is read from the archive, so don't trust a size that would
+    // require an impossible compression ratio or a huge allocation.
+    if (file_info.uncompressed_size > theMaxFileSize ||
+        file_info.uncompressed_size >
+            (file_info.compressed_size + 1) * theMaxCompressionRatio)
+    {
+        throw FileFormatException("Invalid file size in archive.");
+    }
+
+    std::vector<std::byte> buffer(file_info.uncompressed_size);
+
+    size_t offset = 0;
+    while (offset < buffer.size())
     {
-        static constexpr int BLOCK_SIZE = 4096;
-
-        const size_t block_start = buffer.size();
-        buffer.resize(buffer.size() + BLOCK_SIZE);
-        const int bytes_read = unzReadCurrentFile(
-            zip_file, buffer.data() + block_start, BLOCK_SIZE);
-
-        if (bytes_read == 0)
-        {
-            // End of file.
-            break;
-        }
-        else if (bytes_read < 0)
-        {
+        const unsigned int block_size = static_cast<unsigned int>(std::min<size_t>(
+            buffer.size() - offset, std::numeric_limits<int>::max()));
+
+        const int bytes_read =
+            unzReadCurrentFile(zip_file, buffer.data() + offset, block_size);
+        if (bytes_read <= 0)
             throw FileFormatException("Failed to read file.");
-        }
-        else if (bytes_read != BLOCK_SIZE)
-        {
-            // We likely reached the end of the file - trim extra entries that
-            // were allocated.
-            assert(bytes_read < BLOCK_SIZE);
-            buffer.resize(buffer.size() - (BLOCK_SIZE - bytes_read));
-        }
-    };
+
+        offset += bytes_read;
+    }
+
+    // Ensure that there isn't more data than the recorded size. This also
+    // allows minizip to verify the CRC when the file is closed.
+    std::byte extra;
+    if (unzReadCurrentFile(zip_file, &extra, 1) != 0)
+        throw FileFormatException("Failed to read file.");
 
     return buffer;
 }
@@ -420,7 +420,7 @@ saveMasterBars(pugi::xml_node &gpif, const std::vector<MasterBar> &master_bars)
 }
 
 static void
-saveBars(pugi::xml_node &gpif, const std::unordered_map<int, Bar> &bars_map)
+saveBars(pugi::xml_node &gpif, const IdTable<Bar> &bars_map)
 {
     auto bars_node = gpif.append_child("Bars");
 
@@ -436,7 +436,7 @@ saveBars(pugi::xml_node &gpif, const std::unordered_map<int, Bar> &bars_map)
 
 static void
 saveVoices(pugi::xml_node &gpif,
-           const std::unordered_map<int, Voice> &voices_map)
+           const IdTable<Voice> &voices_map)
 {
     auto voices_node = gpif.append_child("Voices");
 
@@ -449,7 +449,7 @@ saveVoices(pugi::xml_node &gpif,
 }
 
 static void
-saveBeats(pugi::xml_node &gpif, const std::unordered_map<int, Beat> &beats_map)
+saveBeats(pugi::xml_node &gpif, const IdTable<Beat> &beats_map)
 {
     auto beats_node = gpif.append_child("Beats");
 
@@ -529,7 +529,7 @@ savePitch(pugi::xml_node &props_node, const char *name,
 }
 
 static void
-saveNotes(pugi::xml_node &gpif, const std::unordered_map<int, Note> &notes_map)
+saveNotes(pugi::xml_node &gpif, const IdTable<Note> &notes_map)
 {
     auto notes_node = gpif.append_child("Notes");
 
@@ -648,7 +648,7 @@ saveNotes(pugi::xml_node &gpif, const std::unordered_map<int, Note> &notes_map)
 
 static void
 saveRhythms(pugi::xml_node &gpif,
-            const std::unordered_map<int, Rhythm> &rhythms_map)
+            const IdTable<Rhythm> &rhythms_map)
 {
     static const std::unordered_map<int, std::string> theNoteNamesMap = {
         { 1, "Whole"s }, { 2, "Half"s }, { 4, "Quarter"s }, { 8, "Eighth" },
@@ -17,20 +17,62 @@
 
 #include "bitstream.h"
 
-#include "util.h"
+#include <algorithm>
 #include <cassert>
 #include <istream>
 
 static constexpr uint32_t BYTE_LENGTH = 8;
+static constexpr int BUFFER_LENGTH = 64;
 
-Gpx::BitStream::BitStream(std::istream &stream) : myPosition(0)
+/// Reads 8 bytes as a big-endian integer, so that the first bit of the stream
+/// is the most significant bit. Compilers turn this into a single load.
+static uint64_t
+loadBigEndian(const std::byte *bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i)
+        value = (value << BYTE_LENGTH) | std::to_integer<uint64_t>(bytes[i]);
+
+    return value;
+}
+
+Gpx::BitStream::BitStream(std::istream &stream)
+    : myPosition(0), myNextByte(0), myBuffer(0), myBufferSize(0)
 {
     // Copy data from the stream into an internal buffer.
     stream.seekg(0, std::ios::end);
     myBytes.resize(stream.tellg());
 
     stream.seekg(0, std::ios::beg);
-    stream.read(reinterpret_cast<char *>(&myBytes[0]), myBytes.size());
+    stream.read(reinterpret_cast<char *>(myBytes.data()), myBytes.size());
+}
+
+void
+Gpx::BitStream::refill()
+{
+    if (myNextByte + sizeof(uint64_t) <= myBytes.size())
+    {
+        // Load the next 8 bytes at once, and keep as many whole bytes as
+        // there is space for. The bits past those bytes are also valid data,
+        // so it doesn't matter that they're loaded again by the next refill.
+        const uint64_t bytes = loadBigEndian(&myBytes[myNextByte]);
+        myBuffer |= bytes >> myBufferSize;
+
+        const int num_bytes = (BUFFER_LENGTH - 1 - myBufferSize) / BYTE_LENGTH;
+        myNextByte += num_bytes;
+        myBufferSize += num_bytes * BYTE_LENGTH;
+        return;
+    }
+
+    // Near the end of the input, load one byte at a time.
+    while (myBufferSize <= BUFFER_LENGTH - static_cast<int>(BYTE_LENGTH) &&
+           myNextByte < myBytes.size())
+    {
+        const uint64_t byte = std::to_integer<uint64_t>(myBytes[myNextByte]);
+        myBuffer |= byte << (BUFFER_LENGTH - BYTE_LENGTH - myBufferSize);
+        ++myNextByte;
+        myBufferSize += BYTE_LENGTH;
+    }
 }
 
 uint32_t
@@ -38,44 +80,48 @@ Gpx::BitStream::readInt()
 {
     assert(myPosition % BYTE_LENGTH == 0);
 
-    const uint32_t value =
-        Gpx::Util::readUInt(myBytes, myPosition / BYTE_LENGTH);
-    myPosition += sizeof(uint32_t) * BYTE_LENGTH;
+    // The integer is stored in little-endian order.
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < sizeof(uint32_t); ++i)
+        value |= static_cast<uint32_t>(readBits(BYTE_LENGTH)) << (i * BYTE_LENGTH);
+
     return value;
 }
 
 bool
 Gpx::BitStream::readBit()
 {
-    if (myPosition / BYTE_LENGTH >= myBytes.size())
-        return 0;
-
-    std::byte byte = myBytes[myPosition / BYTE_LENGTH];
-    byte >>= ((BYTE_LENGTH - 1) - (myPosition % BYTE_LENGTH));
-    byte &= std::byte{ 0x01 };
-
-    ++myPosition;
-
-    return byte != std::byte{ 0 };
+    return readBits(1) != 0;
 }
 
 int32_t
 Gpx::BitStream::readBits(int n, BitOrder order)
 {
-    int32_t value = 0;
+    assert(n >= 0 && n <= 32);
+    if (n == 0)
+        return 0;
+
+    if (myBufferSize < n)
+        refill();
+
+    // Missing bits at the end of the stream are already zero in the buffer,
+    // but shouldn't advance the position.
+    uint32_t value = static_cast<uint32_t>(myBuffer >> (BUFFER_LENGTH - n));
+    const int num_read = std::min(n, myBufferSize);
+    myBuffer <<= n;
+    myBufferSize -= num_read;
+    myPosition += num_read;
 
+    // For the reversed order, the first bit read is the least significant.
     if (order == Reversed)
     {
-        for (int i = 0; i < n; ++i)
-            value |= (readBit() << i);
-    }
-    else
-    {
-        for (int i = n - 1; i >= 0; --i)
-            value |= (readBit() << i);
+        uint32_t reversed = 0;
+        for (int i = 0; i < n; ++i, value >>= 1)
+            reversed = (reversed << 1) | (value & 1);
+        value = reversed;
     }
 
-    return value;
+    return static_cast<int32_t>(value);
 }
 
 size_t
@@ -84,6 +130,12 @@ Gpx::BitStream::getLocation() const
     return myPosition / BYTE_LENGTH;
 }
 
+size_t
+Gpx::BitStream::getSize() const
+{
+    return myBytes.size();
+}
+
 bool
 Gpx::BitStream::isAtEnd() const
 {
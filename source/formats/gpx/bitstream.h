@@ -28,6 +28,8 @@ namespace Gpx
 
 /// Provides the ability to read individual bits from a stream.
 /// This is required for the compression scheme used in .gpx files.
+/// Rather than extracting one bit at a time, the upcoming bits are kept in a
+/// 64-bit buffer which is refilled several bytes at a time.
 class BitStream
 {
 public:
@@ -46,20 +48,34 @@ public:
     /// Reads the next bit from the stream.
     bool readBit();
 
-    /// Reads the next n bits from the stream into an integer.
+    /// Reads the next n bits (at most 32) from the stream into an integer.
+    /// Any bits past the end of the stream are read as zero.
     int32_t readBits(int n, BitOrder = Normal);
 
     /// Returns the position in the stream (measured in bytes).
     size_t getLocation() const;
 
+    /// Returns the total size of the stream (measured in bytes).
+    size_t getSize() const;
+
     /// Returns true if we've reached the end of the stream.
     bool isAtEnd() const;
 
 private:
+    /// Loads bytes into the bit buffer until it holds at least 57 bits or the
+    /// end of the input is reached.
+    void refill();
+
     /// The current position in the input (measured in bits).
     size_t myPosition;
     /// The compressed data being read.
     std::vector<std::byte> myBytes;
+    /// Index of the next byte to be loaded into the bit buffer.
+    size_t myNextByte;
+    /// The upcoming bits, starting from the most significant bit.
+    uint64_t myBuffer;
+    /// The number of valid bits in the buffer.
+    int myBufferSize;
 };
 
 } // namespace Gpx
@@ -21,6 +21,7 @@
 #include "util.h"
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <formats/fileformat.h>
 
 enum ChunkHeader
@@ -46,8 +47,19 @@ Gpx::FileSystem::FileSystem(std::istream &stream)
         throw FileFormatException("Invalid header");
 
     const uint32_t length = input.readInt();
-    std::vector<std::byte> output;
-    output.reserve(length);
+
+    // Write directly into the buffer rather than appending each byte, and
+    // only trim it to the actual size at the end. The length from the header
+    // can't be trusted, so the initial size is limited by the size of the
+    // compressed data and the buffer grows as needed.
+    const size_t MAX_INITIAL_RATIO = 8;
+    std::vector<std::byte> output(
+        std::min<size_t>(length, input.getSize() * MAX_INITIAL_RATIO));
+    size_t output_size = 0;
+    auto reserve = [&](size_t count) {
+        if (output_size + count > output.size())
+            output.resize(std::max(output.size() * 2, output_size + count));
+    };
 
     // We now have a succession of compressed and uncompressed chunks.
     while (!input.isAtEnd() && input.getLocation() < length)
@@ -61,11 +73,12 @@ Gpx::FileSystem::FileSystem(std::istream &stream)
         {
             const int32_t rawLength =
                 input.readBits(2, Gpx::BitStream::Reversed);
+            reserve(rawLength);
 
             for (int32_t i = 0; i < rawLength; ++i)
             {
-                output.push_back(
-                    std::byte{ static_cast<uint8_t>(input.readBits(8)) });
+                output[output_size++] =
+                    std::byte{ static_cast<uint8_t>(input.readBits(8)) };
             }
         }
         // For a compressed chunk, we have a 4-bit integer giving a length P,
@@ -77,41 +90,65 @@ Gpx::FileSystem::FileSystem(std::istream &stream)
         {
             const int32_t p = input.readBits(4);
             const int32_t offset = input.readBits(p, Gpx::BitStream::Reversed);
-            const size_t startPos = output.size() - offset;
+            if (static_cast<size_t>(offset) > output_size)
+                throw FileFormatException("Invalid GPX Format");
+
+            const size_t startPos = output_size - offset;
 
+            // Since the length is at most the offset, the source and
+            // destination never overlap.
             const int32_t length = std::clamp<int32_t>(
                 input.readBits(p, Gpx::BitStream::Reversed), 0, offset);
+            reserve(length);
 
-            std::copy(output.begin() + startPos,
-                      output.begin() + startPos + length,
-                      std::back_inserter(output));
+            std::memcpy(output.data() + output_size, output.data() + startPos,
+                        length);
+            output_size += length;
         }
     }
 
+    output.resize(output_size);
+    if (output.size() < 4)
+        throw FileFormatException("Invalid GPX Format");
+
     // The data we just read should now have a header indicating that it's
     // uncompressed!
     const uint32_t newHeader = Gpx::Util::readUInt(output, 0);
     if (newHeader != BCFS_HEADER)
         throw FileFormatException("Invalid GPX Format");
 
-    readUncompressedData(output);
+    myData = std::move(output);
+    readUncompressedData();
 }
 
-const std::vector<std::byte> &
-Gpx::FileSystem::getFileContents(const std::string &filename) const
+std::span<std::byte>
+Gpx::FileSystem::getFileContents(const std::string &filename)
 {
     auto it = myFiles.find(filename);
     if (it == myFiles.end())
         throw FileFormatException("Invalid filename");
-    else
-        return it->second;
+
+    File &file = it->second;
+    if (file.mySectors.size() == 1)
+        return file.mySectors.front();
+
+    if (file.myContents.empty())
+    {
+        for (std::span<std::byte> sector : file.mySectors)
+        {
+            file.myContents.insert(file.myContents.end(), sector.begin(),
+                                   sector.end());
+        }
+    }
+
+    return file.myContents;
 }
 
 void
-Gpx::FileSystem::readUncompressedData(std::vector<std::byte> &data)
+Gpx::FileSystem::readUncompressedData()
 {
-    // Remove the BCFS header.
-    data.erase(data.begin(), data.begin() + 4);
+    // Skip the BCFS header.
+    const std::span<std::byte> data = std::span(myData).subspan(4);
     size_t offset = 0;
 
     // Read all files from the file system.
@@ -125,24 +162,36 @@ Gpx::FileSystem::readUncompressedData(std::vector<std::byte> &data)
 
             int block = 0;
             int blockCount = 0;
-            std::vector<std::byte> file_data;
+            std::vector<std::span<std::byte>> sectors;
+            size_t available_size = 0;
 
-            // Read the file data.
+            // Find the file's sectors, merging any that are consecutive.
             while ((block =
                         Util::readUInt(data, blockIndex + 4 * blockCount)) != 0)
             {
                 offset = block * SECTOR_SIZE;
-                std::copy(data.begin() + offset,
-                          data.begin() +
-                              std::clamp<size_t>(offset + SECTOR_SIZE, 0,
-                                                 data.size()),
-                          std::back_inserter(file_data));
+                const size_t start = std::min<size_t>(offset, data.size());
+                const size_t sector_size =
+                    std::min<size_t>(offset + SECTOR_SIZE, data.size()) - start;
+
+                if (!sectors.empty() &&
+                    sectors.back().data() + sectors.back().size() ==
+                        data.data() + start)
+                {
+                    sectors.back() = std::span(sectors.back().data(),
+                                               sectors.back().size() +
+                                                   sector_size);
+                }
+                else
+                    sectors.push_back(data.subspan(start, sector_size));
+
+                available_size += sector_size;
                 ++blockCount;
             }
 
             // Read the file name and save the file.
             const uint32_t fileSize = Util::readUInt(data, fileSizeIndex);
-            if (file_data.size() >= fileSize)
+            if (available_size >= fileSize)
             {
                 std::string fileName;
                 std::transform(data.begin() + fileNameIndex,
@@ -153,8 +202,21 @@ Gpx::FileSystem::readUncompressedData(std::vector<std::byte> &data)
                 // Trim extra NULL characters.
                 fileName.erase(fileName.find_last_not_of('\0') + 1);
 
-                file_data.resize(fileSize);
-                myFiles[fileName] = std::move(file_data);
+                // Trim the sectors to the file size.
+                size_t remaining = fileSize;
+                for (auto it = sectors.begin(); it != sectors.end(); ++it)
+                {
+                    if (remaining <= it->size())
+                    {
+                        *it = it->first(remaining);
+                        sectors.erase(it + 1, sectors.end());
+                        break;
+                    }
+
+                    remaining -= it->size();
+                }
+
+                myFiles[fileName] = File{ std::move(sectors), {} };
             }
         }
     }
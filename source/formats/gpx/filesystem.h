@@ -21,6 +21,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -31,19 +32,39 @@ namespace Gpx
 /// The uncompressed *.gpx file is essentially a filesystem containing several
 /// xml files.
 /// This class handles the extraction of information from that filesystem.
+/// Files are indexed as lists of sectors within the decompressed data, and
+/// are only copied if their sectors aren't contiguous.
 class FileSystem
 {
 public:
     FileSystem(std::istream &stream);
 
-    const std::vector<std::byte> &getFileContents(
-        const std::string &filename) const;
+    /// The file index refers into the decompressed data, so copying would
+    /// leave the copy referring to the original's data.
+    FileSystem(const FileSystem &) = delete;
+    FileSystem &operator=(const FileSystem &) = delete;
+
+    /// Returns the contents of the file, which can be modified in place (e.g.
+    /// for parsing). If the file is stored in consecutive sectors, this
+    /// refers directly to the decompressed data. Otherwise, the file is
+    /// assembled the first time it is requested.
+    std::span<std::byte> getFileContents(const std::string &filename);
 
 private:
-    void readUncompressedData(std::vector<std::byte> &data);
+    struct File
+    {
+        /// The parts of the decompressed data containing the file.
+        std::vector<std::span<std::byte>> mySectors;
+        /// The file's contents, if they weren't contiguous.
+        std::vector<std::byte> myContents;
+    };
+
+    void readUncompressedData();
 
-    /// Maps filenames to file contents.
-    std::unordered_map<std::string, std::vector<std::byte>> myFiles;
+    /// The decompressed data.
+    std::vector<std::byte> myData;
+    /// Maps filenames to the location of their contents.
+    std::unordered_map<std::string, File> myFiles;
 };
 
 } // namespace Gpx
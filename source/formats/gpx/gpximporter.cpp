@@ -39,9 +39,10 @@ GpxImporter::load(const std::filesystem::path &filename, Score &score)
     std::ifstream file(filename, std::ios::binary | std::ios::in);
     Gpx::FileSystem fs(file);
 
-    std::vector<std::byte> buffer = fs.getFileContents("score.gpif");
+    // Parse as an XML file. The contents are owned by the filesystem, so they
+    // can be parsed in place without making a copy.
+    std::span<std::byte> buffer = fs.getFileContents("score.gpif");
 
-    // Parse as an XML file.
     pugi::xml_document xml_doc;
     pugi::xml_parse_result result =
         xml_doc.load_buffer_inplace(buffer.data(), buffer.size());
@@ -18,7 +18,7 @@
 #include "util.h"
 
 uint32_t
-Gpx::Util::readUInt(const std::vector<std::byte> &bytes, size_t index)
+Gpx::Util::readUInt(std::span<const std::byte> bytes, size_t index)
 {
     const uint32_t n1 = std::to_integer<uint32_t>(bytes[index]);
     const uint32_t n2 = std::to_integer<uint32_t>(bytes[index + 1]);
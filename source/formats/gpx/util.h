@@ -20,14 +20,14 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <span>
 
 namespace Gpx
 {
 namespace Util
 {
     /// Converts 4 bytes starting at the given index into an integer.
-    uint32_t readUInt(const std::vector<std::byte> &bytes, size_t index);
+    uint32_t readUInt(std::span<const std::byte> bytes, size_t index);
 } // namespace Util
 } // namespace Gpx
 
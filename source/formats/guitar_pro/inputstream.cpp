@@ -17,10 +17,12 @@
 
 #include "inputstream.h"
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 
 #include <formats/fileformat.h>
+#include <util/readall.h>
 
 const std::map<std::string, Gp::Version> theVersionStrings = {
     { "FICHIER GUITAR PRO v3.00", Gp::Version3 },
@@ -31,11 +33,27 @@ const std::map<std::string, Gp::Version> theVersionStrings = {
     { "FICHIER GUITAR PRO v5.10", Gp::Version5_1 }
 };
 
-Gp::InputStream::InputStream(std::istream &stream) : myStream(stream)
+Gp::InputStream::InputStream(std::istream &stream)
 {
-    myStream.exceptions(std::istream::failbit | std::istream::badbit |
-                       std::istream::eofbit);
+    if (!stream)
+        throw FileFormatException("Could not open the file.");
 
+    myBuffer = Util::readAll(stream);
+    if (stream.bad())
+        throw FileFormatException("Error reading the file.");
+
+    myData = std::as_bytes(std::span(myBuffer));
+
+    readVersion();
+}
+
+Gp::InputStream::InputStream(std::span<const std::byte> data) : myData(data)
+{
+    readVersion();
+}
+
+void Gp::InputStream::readVersion()
+{
     const std::string versionString = readVersionString();
 
     auto it = theVersionStrings.find(versionString);
@@ -45,16 +63,25 @@ Gp::InputStream::InputStream(std::istream &stream) : myStream(stream)
         throw FileFormatException("Unsupported file version: " + versionString);
 }
 
+void Gp::InputStream::throwEndOfFile()
+{
+    throw FileFormatException("Unexpected end of file.");
+}
+
 std::string Gp::InputStream::readVersionString()
 {
-    myStream.seekg(std::ios_base::beg);
+    myPosition = 0;
 
     // THe version consists of a 30 character string, although not all 30
     // characters may be used.
     std::string version = readCharacterString<uint8_t>();
 
     // Skip past any unread characters to land at position 0x1f.
-    myStream.seekg(31, std::ios_base::beg);
+    constexpr size_t header_size = 31;
+    if (myData.size() < header_size)
+        throwEndOfFile();
+
+    myPosition = header_size;
 
     return version;
 }
@@ -76,21 +103,32 @@ std::string Gp::InputStream::readFixedLengthString(uint32_t maxLength)
 {
     const uint8_t actualLength = read<uint8_t>();
 
-    std::string str;
+    // Skip over any unused characters.
+    const size_t length = (maxLength != 0) ? maxLength : actualLength;
+    checkAvailable(length);
 
-    if (maxLength != 0)
-        str.resize(maxLength);
-    else
-        str.resize(actualLength);
-
-    if (str.size() != 0)
-        myStream.read(&str[0], str.size());
+    std::string str(reinterpret_cast<const char *>(myData.data()) + myPosition,
+                    std::min<size_t>(actualLength, length));
+    myPosition += length;
 
-    str.resize(actualLength);
     return str;
 }
 
 void Gp::InputStream::skip(int numBytes)
 {
-    myStream.seekg(numBytes, std::ios_base::cur);
+    if (numBytes < 0)
+    {
+        if (static_cast<size_t>(-numBytes) > myPosition)
+            throwEndOfFile();
+
+        myPosition -= static_cast<size_t>(-numBytes);
+    }
+    else
+    {
+        // Some files are missing the padding bytes at the very end (e.g. the
+        // line break info for the last staff in GP5 files), so skipping past
+        // the end is allowed. Any further reads will fail.
+        myPosition += std::min(static_cast<size_t>(numBytes),
+                               myData.size() - myPosition);
+    }
 }
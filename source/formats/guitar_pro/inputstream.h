@@ -19,20 +19,34 @@
 #define FORMATS_GP_STREAM_H
 
 #include <boost/endian/conversion.hpp>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <istream>
-#include <vector>
+#include <span>
+#include <string>
 #include <util/toutf8.h>
 
 #include "document.h"
 
 namespace Gp
 {
+/// Decodes a Guitar Pro file from memory. Reading past the end of the data
+/// throws a FileFormatException.
 class InputStream
 {
 public:
+    /// Reads the entire stream into memory.
     InputStream(std::istream &stream);
 
+    /// Reads from the given data, which must outlive the InputStream.
+    InputStream(std::span<const std::byte> data);
+
+    /// The data may point into the stream's own buffer, so copying would
+    /// leave the copy referring to the original's buffer.
+    InputStream(const InputStream &) = delete;
+    InputStream &operator=(const InputStream &) = delete;
+
     /// Returns the file version.
     Version version() const;
 
@@ -60,6 +74,19 @@ public:
     void skip(int numBytes);
 
 private:
+    /// Reads the file version from the header.
+    void readVersion();
+
+    /// Throws a FileFormatException if fewer than the given number of bytes
+    /// are left to read.
+    void checkAvailable(size_t numBytes) const
+    {
+        if (numBytes > myData.size() - myPosition)
+            throwEndOfFile();
+    }
+
+    [[noreturn]] static void throwEndOfFile();
+
     /// Reads a character string.
     /// The string consists of some number of bytes (encoding the length of the
     /// string, n) followed by n characters.  This is templated on the length
@@ -68,7 +95,10 @@ private:
     template <class LengthPrefixType>
     std::string readCharacterString();
 
-    std::istream &myStream;
+    /// Holds the file contents when reading from a std::istream.
+    std::string myBuffer;
+    std::span<const std::byte> myData;
+    size_t myPosition = 0;
     Version myVersion;
 };
 
@@ -76,8 +106,11 @@ template <class T>
 inline T InputStream::read()
 {
     static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+    checkAvailable(sizeof(T));
+
     T data;
-    myStream.read((char *)&data, sizeof(data));
+    std::memcpy(&data, myData.data() + myPosition, sizeof(data));
+    myPosition += sizeof(data);
     // The values are stored in little-endian format.
     return boost::endian::little_to_native(data);
 }
@@ -96,11 +129,11 @@ inline std::string InputStream::readCharacterString()
 
     const LengthPrefixType length = read<LengthPrefixType>();
 
-    std::string str;
-    str.resize(length);
+    checkAvailable(length);
 
-    if (length != 0)
-        myStream.read(&str[0], length);
+    std::string str(reinterpret_cast<const char *>(myData.data()) + myPosition,
+                    length);
+    myPosition += length;
 
     Util::convertISO88591ToUTF8(str);
 
@@ -25,4 +25,9 @@ inline FileFormat getPowerTabFileFormat()
 	return FileFormat("Power Tab Document", { "pt2" });
 }
 
+inline FileFormat getPowerTabBinaryFileFormat()
+{
+	return FileFormat("Power Tab Binary Document", { "pt2b" });
+}
+
 #endif // COMMON_H
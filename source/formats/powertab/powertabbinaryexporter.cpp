@@ -0,0 +1,43 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "powertabbinaryexporter.h"
+
+#include "common.h"
+
+#include <fstream>
+#include <score/binaryserialization.h>
+#include <score/score.h>
+
+PowerTabBinaryExporter::PowerTabBinaryExporter()
+    : FileFormatExporter(getPowerTabBinaryFileFormat())
+{
+}
+
+void PowerTabBinaryExporter::save(const std::filesystem::path &filename,
+                                  const Score &score)
+{
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    if (!file)
+        throw FileFormatException("Could not open file for writing.");
+
+    ScoreUtils::saveBinary(file, score);
+    file.close();
+
+    if (!file)
+        throw FileFormatException("Failed to write the file.");
+}
@@ -0,0 +1,44 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "powertabbinaryimporter.h"
+
+#include "common.h"
+
+#include <fstream>
+#include <score/binaryserialization.h>
+#include <score/score.h>
+
+PowerTabBinaryImporter::PowerTabBinaryImporter()
+    : FileFormatImporter(getPowerTabBinaryFileFormat())
+{
+}
+
+void PowerTabBinaryImporter::load(const std::filesystem::path &filename,
+                                  Score &score)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+
+    try
+    {
+        ScoreUtils::loadBinary(file, score);
+    }
+    catch (const std::runtime_error &e)
+    {
+        throw FileFormatException(e.what());
+    }
+}
@@ -55,9 +55,10 @@ Position::Position() :
 /// Destructor
 Position::~Position()
 {
+    // The memory is owned by the document's arena.
     for (auto &note : m_noteArray)
     {
-        delete note;
+        std::destroy_at(note);
     }
 }
 
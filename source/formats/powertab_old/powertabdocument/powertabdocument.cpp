@@ -215,14 +215,15 @@ bool Document::Save(const PathType& fileName) const
 
 /// Loads a power tab file.
 /// @param fileName Full path of the file to load.
-/// @throw std::ifstream::failure
+/// @throw FileFormatException
 void Document::Load(const std::filesystem::path& fileName)
 {
     std::ifstream fileStream(fileName,
                              std::ifstream::in | std::ifstream::binary);
-    PowerTabInputStream stream(fileStream);
+    PowerTabInputStream stream(fileStream, m_arena);
 
     DeleteContents();
+    m_arena.release();
 
     // read the header
     if (!m_header.Deserialize(stream))
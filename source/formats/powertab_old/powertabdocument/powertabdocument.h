@@ -17,6 +17,7 @@
 
 #include <array>
 #include <filesystem>
+#include <memory_resource>
 #include <vector>
 
 namespace PowerTabDocument {
@@ -52,6 +53,7 @@ public:
 
     // Member Variables
 private:
+    std::pmr::monotonic_buffer_resource m_arena;                    ///< Memory for the objects that are loaded from a file
     PowerTabFileHeader  m_header;                                   ///< The one and only header (contains file information)
     std::vector<Score*> m_scoreArray;                               ///< List of scores (zeroth element = guitar score, first element = bass score)
 
@@ -14,6 +14,8 @@
 #include "rect.h"
 #include "macros.h"
 
+#include <formats/fileformat.h>
+#include <util/readall.h>
 #include <util/toutf8.h>
 
 #include <algorithm>
@@ -22,11 +24,28 @@ namespace PowerTabDocument {
 
 using std::string;
 
-PowerTabInputStream::PowerTabInputStream(std::istream& stream) :
-    m_stream(stream)
+PowerTabInputStream::PowerTabInputStream(std::istream& stream,
+                                         std::pmr::memory_resource& arena) :
+    m_position(0), m_arena(arena)
 {
-    // ensure that the stream will throw std::ifstream::failure if any errors occur
-    stream.exceptions(std::istream::failbit | std::istream::badbit | std::istream::eofbit);
+    if (!stream)
+        throw FileFormatException("Could not open the file.");
+
+    m_buffer = Util::readAll(stream);
+    if (stream.bad())
+        throw FileFormatException("Error reading the file.");
+
+    m_data = std::as_bytes(std::span(m_buffer));
+}
+
+void PowerTabInputStream::ThrowEndOfFile()
+{
+    throw FileFormatException("Unexpected end of file.");
+}
+
+void PowerTabInputStream::ThrowInvalidSize()
+{
+    throw FileFormatException("Invalid array size.");
 }
 
 // Read Functions
@@ -61,8 +80,9 @@ void PowerTabInputStream::ReadMFCString(string& str)
     if (length == 0)
         return;
 
-    str.resize(length);
-    m_stream.read(&str[0], length);
+    CheckAvailable(length);
+    str.assign(reinterpret_cast<const char*>(m_data.data()) + m_position, length);
+    m_position += length;
 
     // Convert from ISO 8859-1 to UTF8
     Util::convertISO88591ToUTF8(str);
@@ -135,7 +155,7 @@ void PowerTabInputStream::ReadClassInformation()
 
         *this >> schema;
         *this >> length;
-        m_stream.seekg(length, std::ios_base::cur);
+        Skip(length);
     }
 
     // otherwise, existing class index in obj_tag followed by new object
@@ -13,9 +13,14 @@
 #define POWERTABINPUTSTREAM_H
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <istream>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
 #include <vector>
 
 namespace PowerTabDocument {
@@ -24,14 +29,22 @@ class Rect;
 class Colour;
 
 /// Input stream used to deserialize MFC based Power Tab data
+/// The entire stream is read into memory up front, and any attempt to read
+/// past the end of the data throws a FileFormatException.
 class PowerTabInputStream
 {
     // Member Variables
 private:
-    std::istream& m_stream;
+    std::string m_buffer;                   ///< Contents of the input stream
+    std::span<const std::byte> m_data;      ///< Data that is being read
+    size_t m_position;                      ///< Current read position in the data
+    std::pmr::memory_resource& m_arena;     ///< Memory for the objects that are read (see ReadObject)
 
 public:
-    PowerTabInputStream(std::istream& stream);
+    /// @param arena Memory resource for the objects that are read. Objects
+    /// stored by raw pointer are only destroyed by their owners, never
+    /// deallocated, so this must be an arena that outlives them.
+    PowerTabInputStream(std::istream& stream, std::pmr::memory_resource& arena);
 
     // Read Functions
     uint32_t ReadCount();
@@ -43,6 +56,32 @@ private:
     void ReadClassInformation();
     uint32_t ReadMFCStringLength();
 
+    /// Copies the next bytes from the stream
+    void ReadBytes(void* dest, size_t count)
+    {
+        CheckAvailable(count);
+        if (count != 0)
+            std::memcpy(dest, m_data.data() + m_position, count);
+        m_position += count;
+    }
+
+    /// Skips over the next bytes in the stream
+    void Skip(size_t count)
+    {
+        CheckAvailable(count);
+        m_position += count;
+    }
+
+    /// Throws a FileFormatException if there are fewer than the given number
+    /// of bytes left to read
+    void CheckAvailable(size_t count) const
+    {
+        if (count > m_data.size() - m_position)
+            ThrowEndOfFile();
+    }
+
+    [[noreturn]] static void ThrowEndOfFile();
+
 public:
 
     template <class T>
@@ -61,11 +100,11 @@ public:
     }
 
     /// Read data from the input stream
-    /// @throw std::ifstream::failure if any errors occur
+    /// @throw FileFormatException if the end of the data is reached
     template<class T>
     inline PowerTabInputStream& operator>>(T& data)
     {
-        m_stream.read(reinterpret_cast<char *>(&data), sizeof(data));
+        ReadBytes(&data, sizeof(data));
         return *this;
     }
 
@@ -78,7 +117,7 @@ public:
         vect.clear();
         vect.resize(size);
 
-        m_stream.read((char*)&vect[0], size * sizeof(T));
+        ReadBytes(vect.data(), size * sizeof(T));
     }
 
     template <class T, size_t N>
@@ -87,25 +126,42 @@ public:
         uint8_t size = 0;
         *this >> size;
 
-        m_stream.read((char*)&array[0], size * sizeof(T));
+        if (size > N)
+            ThrowInvalidSize();
+
+        ReadBytes(array.data(), size * sizeof(T));
     }
 
 private:
+    [[noreturn]] static void ThrowInvalidSize();
+
+    /// Objects are allocated from the arena, since the document is usually
+    /// only loaded to be converted and then discarded in one go.
     template <class T>
     inline void ReadObject(std::vector<T*>& vect, uint16_t version)
     {
-        std::unique_ptr<T> object(new T());
-        object->Deserialize(*this, version);
-        vect.push_back(object.release());
+        std::pmr::polymorphic_allocator<T> allocator(&m_arena);
+        T* object = allocator.template new_object<T>();
+        try
+        {
+            object->Deserialize(*this, version);
+            vect.push_back(object);
+        }
+        catch (...)
+        {
+            std::destroy_at(object);
+            throw;
+        }
     }
 
     template <class T>
     inline void ReadObject(std::vector<std::shared_ptr<T> >& vect,
                            uint16_t version)
     {
-        std::shared_ptr<T> object(std::make_shared<T>());
+        std::shared_ptr<T> object(std::allocate_shared<T>(
+            std::pmr::polymorphic_allocator<T>(&m_arena)));
         object->Deserialize(*this, version);
-        vect.push_back(object);
+        vect.push_back(std::move(object));
     }
 };
 
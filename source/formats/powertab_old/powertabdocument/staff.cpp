@@ -70,10 +70,11 @@ Staff::~Staff()
 {
     for (size_t i = 0; i < positionArrays.size(); i++)
     {
+        // The memory is owned by the document's arena.
         std::vector<Position*>& positionArray = positionArrays[i];
         for (size_t j = 0; j < positionArray.size(); j++)
         {
-            delete positionArray[j];
+            std::destroy_at(positionArray[j]);
         }
     }
 }
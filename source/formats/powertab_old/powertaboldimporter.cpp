@@ -39,6 +39,7 @@
 #include <score/systemlocation.h>
 #include <score/utils/scoremerger.h>
 #include <score/utils/scorepolisher.h>
+#include <util/parallelfor.h>
 
 #include <cmath>
 #include <unordered_map>
@@ -63,14 +64,14 @@ void PowerTabOldImporter::load(const std::filesystem::path &filename,
     
     assert(document.GetNumberOfScores() == 2);
 
-    // Convert the guitar score.
+    // Convert the guitar and bass scores, and then merge them. The
+    // conversions don't share any state, so they can be done concurrently.
 #if 1
     Score guitarScore;
-    convert(*document.GetScore(0), guitarScore);
-
-    // Convert and then merge the bass score.
     Score bassScore;
-    convert(*document.GetScore(1), bassScore);
+    Util::parallelFor(2, [&](int i) {
+        convert(*document.GetScore(i), i == 0 ? guitarScore : bassScore);
+    });
     ScoreMerger::merge(score, guitarScore, bassScore);
 
     // Reformat the score, since the guitar and bass score from v1.7 may have
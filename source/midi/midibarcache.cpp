@@ -0,0 +1,75 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "midibarcache.h"
+
+#include <limits>
+
+std::shared_ptr<const MidiBarEvents>
+MidiBarCache::find(int system, int bar_position, Midi::Tempo tempo,
+                   const std::vector<uint16_t> &bends) const
+{
+    std::lock_guard lock(myMutex);
+
+    auto it = myBars.find({ system, bar_position });
+    if (it == myBars.end())
+        return nullptr;
+
+    const MidiBarEvents &bar = *it->second;
+    if (bar.myInitialTempo != tempo || bar.myInitialBends != bends)
+        return nullptr;
+
+    return it->second;
+}
+
+void MidiBarCache::insert(int system, int bar_position,
+                          std::shared_ptr<const MidiBarEvents> bar,
+                          uint64_t generation)
+{
+    std::lock_guard lock(myMutex);
+    if (generation == myGeneration)
+        myBars[{ system, bar_position }] = std::move(bar);
+}
+
+void MidiBarCache::invalidateSystem(int system)
+{
+    std::lock_guard lock(myMutex);
+    constexpr int min_position = std::numeric_limits<int>::min();
+    myBars.erase(myBars.lower_bound({ system - 1, min_position }),
+                 myBars.lower_bound({ system + 2, min_position }));
+    ++myGeneration;
+}
+
+void MidiBarCache::clear()
+{
+    std::lock_guard lock(myMutex);
+    myBars.clear();
+    ++myGeneration;
+}
+
+uint64_t MidiBarCache::setOptions(const MidiFile::LoadOptions &options)
+{
+    std::lock_guard lock(myMutex);
+    if (myOptions != options)
+    {
+        myBars.clear();
+        myOptions = options;
+        ++myGeneration;
+    }
+
+    return myGeneration;
+}
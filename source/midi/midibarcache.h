@@ -0,0 +1,90 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MIDI_MIDIBARCACHE_H
+#define MIDI_MIDIBARCACHE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <midi/midifile.h>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+/// The events generated for all staves in a bar, with ticks relative to the
+/// start of the bar.
+struct MidiBarEvents
+{
+    /// The tempo and pitch bend for each staff at the start of the bar, which
+    /// the generated events depend on.
+    Midi::Tempo myInitialTempo;
+    std::vector<uint16_t> myInitialBends;
+
+    /// The pitch bend for each staff at the end of the bar.
+    std::vector<uint16_t> myFinalBends;
+    /// The duration of the bar in ticks.
+    int myDuration = 0;
+    /// The events for each player's track.
+    std::vector<MidiEventList> myTracks;
+};
+
+/// Stores the MIDI events that were generated for each bar of a score, so
+/// that MidiFile::load() only needs to regenerate the bars that were edited
+/// rather than the entire score.
+/// The owner must call invalidateSystem() or clear() whenever the score is
+/// modified. This can be safely accessed from multiple threads.
+///
+/// Since events may be generated from a copy of the score on another thread,
+/// each invalidation starts a new generation. Bars are only inserted if they
+/// were generated in the current generation, so that bars from an outdated
+/// copy of the score are ignored.
+class MidiBarCache
+{
+public:
+    /// Returns the cached events for the bar, if they were generated from the
+    /// same initial tempo and pitch bends.
+    std::shared_ptr<const MidiBarEvents>
+    find(int system, int bar_position, Midi::Tempo tempo,
+         const std::vector<uint16_t> &bends) const;
+
+    /// Stores the bar, unless the cache has been invalidated since the given
+    /// generation (from setOptions()) began.
+    void insert(int system, int bar_position,
+                std::shared_ptr<const MidiBarEvents> bar, uint64_t generation);
+
+    /// Discards the bars in the system. Since ties and slides can depend on
+    /// the adjacent systems, their bars are also discarded.
+    void invalidateSystem(int system);
+
+    /// Discards all cached bars.
+    void clear();
+
+    /// Discards all cached bars if they were generated with different
+    /// options. This should be called when taking the score that the events
+    /// are generated from, and returns the current generation.
+    uint64_t setOptions(const MidiFile::LoadOptions &options);
+
+private:
+    mutable std::mutex myMutex;
+    /// Cached bars, indexed by system and the position of the bar.
+    std::map<std::pair<int, int>, std::shared_ptr<const MidiBarEvents>> myBars;
+    std::optional<MidiFile::LoadOptions> myOptions;
+    uint64_t myGeneration = 0;
+};
+
+#endif
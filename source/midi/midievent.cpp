@@ -19,6 +19,7 @@
 
 #include <score/generalmidi.h>
 
+#include <algorithm>
 #include <cassert>
 
 enum Controller : uint8_t
@@ -43,10 +44,15 @@ static const uint8_t theSysExManufacturerId = 0x7d;
 static const uint8_t theChannelMask = 0x0f;
 static const uint8_t theStatusByteMask = ~theChannelMask;
 
-MidiEvent::MidiEvent(int ticks, std::vector<uint8_t> data,
+MidiEvent::MidiEvent(int ticks, std::initializer_list<uint8_t> data,
                      const SystemLocation &location)
-    : myTicks(ticks), myData(std::move(data)), myLocation(location)
+    : myTicks(ticks),
+      myData(),
+      mySize(static_cast<uint8_t>(data.size())),
+      myLocation(location)
 {
+    assert(data.size() <= MAX_DATA_SIZE);
+    std::copy(data.begin(), data.end(), myData.begin());
 }
 
 MidiEvent MidiEvent::endOfTrack(int ticks)
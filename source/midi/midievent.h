@@ -20,8 +20,11 @@
 
 #include <score/systemlocation.h>
 
+#include <array>
 #include <chrono>
 #include <cstdint>
+#include <initializer_list>
+#include <span>
 #include <vector>
 
 namespace Midi
@@ -54,7 +57,10 @@ public:
     int getTicks() const { return myTicks; }
     void setTicks(int ticks) { myTicks = ticks; }
     uint8_t getStatusByte() const { return myData[0]; }
-    const std::vector<uint8_t> &getData() const { return myData; }
+    std::span<const uint8_t> getData() const
+    {
+        return { myData.data(), mySize };
+    }
     const SystemLocation &getLocation() const { return myLocation; }
 
     bool isMetaMessage() const;
@@ -86,12 +92,18 @@ public:
     static std::vector<MidiEvent> pitchWheelRange(int ticks, uint8_t channel,
                                                   uint8_t semitones);
 
+    /// The size of the largest message that is generated (a tempo change).
+    static constexpr size_t MAX_DATA_SIZE = 6;
+
 private:
-    MidiEvent(int ticks, std::vector<uint8_t> data,
+    MidiEvent(int ticks, std::initializer_list<uint8_t> data,
               const SystemLocation &location);
 
     int myTicks; // TODO - does this need to be 64-bit for absolute times?
-    std::vector<uint8_t> myData;
+    /// The message is stored inline rather than in a separate allocation,
+    /// since there can be a very large number of events.
+    std::array<uint8_t, MAX_DATA_SIZE> myData;
+    uint8_t mySize;
 
     SystemLocation myLocation;
 };
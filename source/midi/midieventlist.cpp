@@ -63,7 +63,8 @@ void MidiEventList::convertToAbsoluteTicks()
 
 void MidiEventList::concat(const MidiEventList &other)
 {
-    myEvents.reserve(myEvents.size() + other.myEvents.size());
+    // Don't reserve the exact size here, since that would defeat the
+    // vector's geometric growth when concatenating many lists.
     myEvents.insert(myEvents.end(), other.myEvents.begin(),
                     other.myEvents.end());
 }
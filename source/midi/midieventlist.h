@@ -39,6 +39,10 @@ public:
 
     void concat(const MidiEventList &other);
 
+    void reserve(size_t size) { myEvents.reserve(size); }
+    void clear() { myEvents.clear(); }
+    size_t size() const { return myEvents.size(); }
+
     typedef std::vector<MidiEvent>::iterator iterator;
     typedef std::vector<MidiEvent>::const_iterator const_iterator;
 
@@ -0,0 +1,70 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "midieventmerger.h"
+
+#include <algorithm>
+
+MidiEventMerger::MidiEventMerger(const std::vector<MidiEventList> &tracks)
+    : myCurrentTicks(0)
+{
+    myHeap.reserve(tracks.size());
+    for (int i = 0, n = static_cast<int>(tracks.size()); i < n; ++i)
+    {
+        const MidiEventList &track = tracks[i];
+        if (track.begin() != track.end())
+        {
+            myHeap.push_back(
+                { track.begin(), track.end(), track.begin()->getTicks(), i });
+        }
+    }
+
+    std::make_heap(myHeap.begin(), myHeap.end(), &MidiEventMerger::isLater);
+}
+
+bool MidiEventMerger::isLater(const Cursor &a, const Cursor &b)
+{
+    if (a.myTicks != b.myTicks)
+        return a.myTicks > b.myTicks;
+
+    return a.myTrackIndex > b.myTrackIndex;
+}
+
+std::optional<MidiEvent> MidiEventMerger::next()
+{
+    if (myHeap.empty())
+        return std::nullopt;
+
+    std::pop_heap(myHeap.begin(), myHeap.end(), &MidiEventMerger::isLater);
+    Cursor &cursor = myHeap.back();
+
+    MidiEvent event = *cursor.myPosition;
+    event.setTicks(cursor.myTicks - myCurrentTicks);
+    myCurrentTicks = cursor.myTicks;
+
+    // Advance the track, and put it back into the heap if there are any
+    // events remaining.
+    if (++cursor.myPosition != cursor.myEnd)
+    {
+        cursor.myTicks += cursor.myPosition->getTicks();
+        std::push_heap(myHeap.begin(), myHeap.end(), &MidiEventMerger::isLater);
+    }
+    else
+        myHeap.pop_back();
+
+    return event;
+}
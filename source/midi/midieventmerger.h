@@ -0,0 +1,58 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MIDI_MIDIEVENTMERGER_H
+#define MIDI_MIDIEVENTMERGER_H
+
+#include <midi/midieventlist.h>
+#include <optional>
+#include <vector>
+
+/// Merges several tracks into a single stream of events ordered by time,
+/// without copying or modifying the tracks.
+/// The tracks must be sorted and use delta ticks (e.g. after
+/// MidiFile::load()). Events with the same timestamp are returned in track
+/// order, matching a stable sort of the concatenated tracks.
+class MidiEventMerger
+{
+public:
+    explicit MidiEventMerger(const std::vector<MidiEventList> &tracks);
+
+    /// Returns the next event, with its ticks relative to the previously
+    /// returned event, or std::nullopt once all of the tracks are exhausted.
+    std::optional<MidiEvent> next();
+
+private:
+    struct Cursor
+    {
+        MidiEventList::const_iterator myPosition;
+        MidiEventList::const_iterator myEnd;
+        /// Absolute time of the event at myPosition.
+        int myTicks;
+        int myTrackIndex;
+    };
+
+    /// Orders the heap so that the earliest event is at the front.
+    static bool isLater(const Cursor &a, const Cursor &b);
+
+    /// Min-heap of the tracks that still have events remaining.
+    std::vector<Cursor> myHeap;
+    /// Absolute time of the last event that was returned.
+    int myCurrentTicks;
+};
+
+#endif
@@ -0,0 +1,138 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "midieventstream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <midi/midibarcache.h>
+#include <vector>
+
+namespace
+{
+/// An event that has been generated but can't be released yet, since an
+/// earlier event might still be generated.
+struct PendingEvent
+{
+    MidiEvent myEvent;
+    int myTrackIndex;
+    /// Preserves the order of events with the same timestamp in a track.
+    uint64_t mySequence;
+};
+
+/// Orders the heap so that the earliest event is at the front. This matches
+/// the order of a stable sort of each track followed by a MidiEventMerger.
+bool isLater(const PendingEvent &a, const PendingEvent &b)
+{
+    if (a.myEvent.getTicks() != b.myEvent.getTicks())
+        return a.myEvent.getTicks() > b.myEvent.getTicks();
+    if (a.myTrackIndex != b.myTrackIndex)
+        return a.myTrackIndex > b.myTrackIndex;
+
+    return a.mySequence > b.mySequence;
+}
+} // namespace
+
+MidiEventStream::MidiEventStream(const Score &score,
+                                 const MidiFile::LoadOptions &options,
+                                 MidiBarCache *cache)
+    : myScore(score),
+      myQueue(QUEUE_SIZE),
+      myTicksPerBeat(MidiFile().getTicksPerBeat())
+{
+    // Record the cache's generation along with the copy of the score.
+    const uint64_t cache_generation = cache ? cache->setOptions(options) : 0;
+    myThread = std::thread(
+        [=, this]() { generate(options, cache, cache_generation); });
+}
+
+MidiEventStream::~MidiEventStream()
+{
+    // Stop the generator if it is still running.
+    myQueue.close();
+    myThread.join();
+}
+
+std::optional<MidiEvent> MidiEventStream::next()
+{
+    std::optional<MidiEvent> event = myQueue.pop();
+    if (!event && myError)
+        std::rethrow_exception(myError);
+
+    return event;
+}
+
+void MidiEventStream::generate(const MidiFile::LoadOptions &options,
+                               MidiBarCache *cache, uint64_t cache_generation)
+{
+    std::vector<PendingEvent> pending;
+    uint64_t sequence = 0;
+    int current_ticks = 0;
+
+    try
+    {
+        MidiFile file;
+        file.generate(
+            myScore, options, cache, cache_generation,
+            [&](std::vector<MidiEventList> &tracks, int min_tick)
+            {
+                // The metronome track is last, and is only included in
+                // MidiFile::load() if it is enabled.
+                int num_tracks = static_cast<int>(tracks.size());
+                if (!options.myEnableMetronome)
+                    --num_tracks;
+
+                for (int i = 0; i < num_tracks; ++i)
+                {
+                    for (const MidiEvent &event : tracks[i])
+                    {
+                        pending.push_back({ event, i, sequence++ });
+                        std::push_heap(pending.begin(), pending.end(),
+                                       isLater);
+                    }
+                }
+
+                for (MidiEventList &track : tracks)
+                    track.clear();
+
+                // Release any events that can't be preceded by events from
+                // the remaining bars.
+                while (!pending.empty() &&
+                       pending.front().myEvent.getTicks() < min_tick)
+                {
+                    std::pop_heap(pending.begin(), pending.end(), isLater);
+                    MidiEvent event = std::move(pending.back().myEvent);
+                    pending.pop_back();
+
+                    const int ticks = event.getTicks();
+                    event.setTicks(ticks - current_ticks);
+                    current_ticks = ticks;
+
+                    if (!myQueue.push(std::move(event)))
+                        return false;
+                }
+
+                return true;
+            });
+    }
+    catch (...)
+    {
+        myError = std::current_exception();
+    }
+
+    myQueue.close();
+}
@@ -0,0 +1,67 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MIDI_MIDIEVENTSTREAM_H
+#define MIDI_MIDIEVENTSTREAM_H
+
+#include <exception>
+#include <midi/midifile.h>
+#include <optional>
+#include <score/score.h>
+#include <thread>
+#include <util/spscqueue.h>
+
+/// Generates the events for a score on a background thread, so that playback
+/// can begin without waiting for the entire score to be processed.
+/// The events are returned in the same order and with the same delta ticks as
+/// merging the tracks from MidiFile::load() with a MidiEventMerger.
+class MidiEventStream
+{
+public:
+    /// Starts generating events from a copy of the score, since the original
+    /// may be modified during playback (e.g. from the mixer). The cache must
+    /// not be destroyed until the stream is destroyed. If the score is edited
+    /// before the stream finishes, the remaining bars are not cached.
+    MidiEventStream(const Score &score, const MidiFile::LoadOptions &options,
+                    MidiBarCache *cache = nullptr);
+    ~MidiEventStream();
+
+    MidiEventStream(const MidiEventStream &) = delete;
+    MidiEventStream &operator=(const MidiEventStream &) = delete;
+
+    int getTicksPerBeat() const { return myTicksPerBeat; }
+
+    /// Waits for the next event, or returns std::nullopt once all of the
+    /// events have been returned. Any exception from generating the events is
+    /// rethrown here.
+    std::optional<MidiEvent> next();
+
+private:
+    void generate(const MidiFile::LoadOptions &options, MidiBarCache *cache,
+                  uint64_t cache_generation);
+
+    /// Maximum number of events that are generated ahead of playback.
+    static constexpr size_t QUEUE_SIZE = 4096;
+
+    const Score myScore;
+    Util::SpscQueue<MidiEvent> myQueue;
+    int myTicksPerBeat;
+    std::exception_ptr myError;
+    std::thread myThread;
+};
+
+#endif
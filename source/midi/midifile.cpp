@@ -17,10 +17,13 @@
   
 #include "midifile.h"
 
+#include "midibarcache.h"
 #include "repeatcontroller.h"
 
 #include <boost/rational.hpp>
 #include <chrono>
+#include <iterator>
+#include <limits>
 #include <optional>
 
 #include <score/generalmidi.h>
@@ -36,6 +39,9 @@ static constexpr int DEFAULT_PPQ = 480;
 static constexpr int PITCH_BEND_RANGE = 24;
 static constexpr int DEFAULT_BEND = Midi::DEFAULT_BEND;
 static constexpr int SLIDE_OUT_STEPS = 5;
+/// Upper bound on the duration of a grace note (see getGraceNoteTicks()),
+/// which holds for tempos up to several thousand bpm.
+static constexpr int MAX_GRACE_NOTE_TICKS = 4 * DEFAULT_PPQ;
 
 /// Pitch bend amount to bend a note by a quarter tone.
 static const boost::rational<int> BEND_QUARTER_TONE(
@@ -115,7 +121,7 @@ static SystemLocation moveToNextBar(MidiEventList &event_list, int ticks,
     return location;
 }
 
-MidiFile::MidiFile() : myTicksPerBeat(0)
+MidiFile::MidiFile() : myTicksPerBeat(DEFAULT_PPQ)
 {
 }
 
@@ -137,19 +143,43 @@ initializeChannel(MidiEventList &events, int channel)
     events.append(MidiEvent::pitchWheel(0, channel, DEFAULT_BEND));
 }
 
-void MidiFile::load(const Score &score, const LoadOptions &options)
+void MidiFile::load(const Score &score, const LoadOptions &options,
+                    MidiBarCache *cache)
+{
+    const uint64_t cache_generation = cache ? cache->setOptions(options) : 0;
+    generate(score, options, cache, cache_generation,
+             [&](std::vector<MidiEventList> &tracks, int min_tick)
+             {
+                 if (min_tick == std::numeric_limits<int>::max())
+                     myTracks = std::move(tracks);
+                 return true;
+             });
+
+    if (!options.myEnableMetronome)
+        myTracks.pop_back();
+
+    for (MidiEventList &track : myTracks)
+        track.convertToDeltaTicks();
+}
+
+void MidiFile::generate(const Score &score, const LoadOptions &options,
+                        MidiBarCache *cache, uint64_t cache_generation,
+                        const EventHandler &handler)
 {
     myTicksPerBeat = DEFAULT_PPQ;
 
     RepeatController repeat_controller(score);
 
-    MidiEventList master_track;
-    MidiEventList metronome_track;
+    // The master track is followed by a track for each player, and then the
+    // metronome track.
+    const int num_players = static_cast<int>(score.getPlayers().size());
+    std::vector<MidiEventList> tracks(num_players + 2);
+    MidiEventList &master_track = tracks.front();
+    MidiEventList &metronome_track = tracks.back();
 
     // Set the initial channel volume and pitch bend range..
-    std::vector<MidiEventList> regular_tracks(score.getPlayers().size());
-    for (unsigned int i = 0; i < score.getPlayers().size(); ++i)
-        initializeChannel(regular_tracks[i], Midi::getPlayerChannel(i));
+    for (int i = 0; i < num_players; ++i)
+        initializeChannel(tracks[i + 1], Midi::getPlayerChannel(i));
 
     SystemLocation location(0, 0);
     std::vector<uint16_t> active_bends;
@@ -175,22 +205,37 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
                           location, repeat_controller,
                           current_bar.getPosition(), next_bar.getPosition());
 
-        for (unsigned int staff_index = 0; staff_index < system.getStaves().size();
-             ++staff_index)
+        // Reuse the events from a previous load if the bar hasn't changed.
+        std::shared_ptr<const MidiBarEvents> bar;
+        if (cache)
+        {
+            bar = cache->find(location.getSystem(), current_bar.getPosition(),
+                              current_tempo, active_bends);
+        }
+
+        if (!bar)
         {
-            const Staff &staff = system.getStaves()[staff_index];
+            bar = generateBar(score, system, location.getSystem(),
+                              current_tempo, active_bends,
+                              current_bar.getPosition(),
+                              next_bar.getPosition(), options);
+
+            if (cache)
+            {
+                cache->insert(location.getSystem(), current_bar.getPosition(),
+                              bar, cache_generation);
+            }
+        }
+
+        active_bends = bar->myFinalBends;
+        current_tick = start_tick + bar->myDuration;
 
-            for (unsigned int voice_index = 0; voice_index < staff.getVoices().size();
-                 ++voice_index)
+        for (size_t i = 0; i < bar->myTracks.size(); ++i)
+        {
+            for (MidiEvent event : bar->myTracks[i])
             {
-                const int end_tick = addEventsForBar(
-                    regular_tracks, active_bends[staff_index], start_tick,
-                    current_tempo, score, system, location.getSystem(), staff,
-                    staff_index, staff.getVoices()[voice_index], voice_index,
-                    current_bar.getPosition(), next_bar.getPosition(),
-                    options);
-
-                current_tick = std::max(current_tick, end_tick);
+                event.setTicks(event.getTicks() + start_tick);
+                tracks[i + 1].append(event);
             }
         }
 
@@ -209,18 +254,50 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
         location = moveToNextBar(
             metronome_track, current_tick, options.myRecordPositionChanges,
             system, location, next_bar.getPosition(), repeat_controller);
+
+        // The next bar starts at the current tick, but grace notes at the
+        // start of the bar may be placed slightly earlier.
+        if (!handler(tracks, current_tick - MAX_GRACE_NOTE_TICKS))
+            return;
     }
 
-    myTracks.push_back(master_track);
-    myTracks.insert(myTracks.end(), regular_tracks.begin(), regular_tracks.end());
-    if (options.myEnableMetronome)
-        myTracks.push_back(metronome_track);
+    for (MidiEventList &track : tracks)
+        track.append(MidiEvent::endOfTrack(current_tick));
 
-    for (MidiEventList &track : myTracks)
+    handler(tracks, std::numeric_limits<int>::max());
+}
+
+std::shared_ptr<const MidiBarEvents>
+MidiFile::generateBar(const Score &score, const System &system,
+                      int system_index, Midi::Tempo tempo,
+                      const std::vector<uint16_t> &bends, int bar_start,
+                      int bar_end, const LoadOptions &options)
+{
+    auto bar = std::make_shared<MidiBarEvents>();
+    bar->myInitialTempo = tempo;
+    bar->myInitialBends = bends;
+    bar->myFinalBends = bends;
+    bar->myTracks.resize(score.getPlayers().size());
+
+    for (unsigned int staff_index = 0; staff_index < system.getStaves().size();
+         ++staff_index)
     {
-        track.append(MidiEvent::endOfTrack(current_tick));
-        track.convertToDeltaTicks();
+        const Staff &staff = system.getStaves()[staff_index];
+
+        for (unsigned int voice_index = 0;
+             voice_index < staff.getVoices().size(); ++voice_index)
+        {
+            const int end_tick = addEventsForBar(
+                bar->myTracks, bar->myFinalBends[staff_index], 0, tempo,
+                score, system, system_index, staff, staff_index,
+                staff.getVoices()[voice_index], voice_index, bar_start,
+                bar_end, options);
+
+            bar->myDuration = std::max(bar->myDuration, end_tick);
+        }
     }
+
+    return bar;
 }
 
 int MidiFile::generateMetronome(MidiEventList &event_list, int current_tick,
@@ -21,10 +21,14 @@
 #include <midi/midieventlist.h>
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 
 class Barline;
 class ConstScoreLocation;
+class MidiBarCache;
+struct MidiBarEvents;
 class RepeatController;
 class Score;
 class Staff;
@@ -55,15 +59,36 @@ public:
         uint8_t myWeakAccentVel;
         uint8_t myMetronomePreset;
         bool myRecordPositionChanges;
+
+        bool operator==(const LoadOptions &) const = default;
     };
 
+    /// Receives the events from generate() after each bar, and may remove
+    /// events from the tracks. Any events generated afterwards will not occur
+    /// before min_tick. Generation stops if this returns false.
+    using EventHandler = std::function<bool(std::vector<MidiEventList> &tracks,
+                                            int min_tick)>;
+
     MidiFile();
     MidiFile(const MidiFile &) = delete;
     MidiFile &operator=(const MidiFile &) = delete;
     MidiFile(MidiFile &&) = default;
     MidiFile &operator=(MidiFile &&) = delete;
 
-    void load(const Score &score, const LoadOptions &options);
+    /// Generates the events for the score. If a cache is provided, the
+    /// events for any unmodified bars are reused from the previous load.
+    void load(const Score &score, const LoadOptions &options,
+              MidiBarCache *cache = nullptr);
+    /// Generates the events for the score incrementally, without storing
+    /// them in the file. The events use absolute ticks and the tracks are
+    /// ordered as in getTracks(), with the metronome track always included.
+    /// Once all events have been generated, the handler is called a final
+    /// time with a min_tick of std::numeric_limits<int>::max().
+    /// If a cache is provided, cache_generation must be the result of calling
+    /// setOptions() on the cache when the score was taken.
+    void generate(const Score &score, const LoadOptions &options,
+                  MidiBarCache *cache, uint64_t cache_generation,
+                  const EventHandler &handler);
     void loadSingleNote(const Score &score, const ConstScoreLocation &location,
                         const LoadOptions &options);
 
@@ -84,6 +109,13 @@ private:
                               const RepeatController &repeat_controller,
                               int bar_start, int bar_end);
 
+    /// Generates the events for all staves in a bar, with ticks relative to
+    /// the start of the bar.
+    std::shared_ptr<const MidiBarEvents>
+    generateBar(const Score &score, const System &system, int system_index,
+                Midi::Tempo tempo, const std::vector<uint16_t> &bends,
+                int bar_start, int bar_end, const LoadOptions &options);
+
     int addEventsForBar(std::vector<MidiEventList> &tracks,
                         uint16_t &active_bend, int current_tick,
                         Midi::Tempo current_tempo, const Score &score,
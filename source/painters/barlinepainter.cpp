@@ -27,7 +27,7 @@
 
 const double BarlinePainter::DOUBLE_BAR_WIDTH = 4;
 
-BarlinePainter::BarlinePainter(const LayoutConstPtr &layout,
+BarlinePainter::BarlinePainter(const LayoutInfo &layout,
                                const Barline &barline,
                                const ConstScoreLocation &location,
                                const ScoreClickEvent &click_event,
@@ -35,7 +35,7 @@ BarlinePainter::BarlinePainter(const LayoutConstPtr &layout,
     : ClickableItem(
           QCoreApplication::translate("ScoreArea", "Click to edit barline."),
           click_event, location, ScoreItem::Barline),
-      myLayout(layout),
+      myGeometry(layout),
       myBarline(barline),
       myX(0),
       myWidth(0),
@@ -54,7 +54,7 @@ BarlinePainter::BarlinePainter(const LayoutConstPtr &layout,
         break;
     }
 
-    myX = LayoutInfo::centerItem(myX, myX + layout->getPositionSpacing(),
+    myX = LayoutInfo::centerItem(myX, myX + layout.getPositionSpacing(),
                                  myWidth);
 
     // Adjust alignment for repeat barlines.
@@ -70,8 +70,8 @@ BarlinePainter::BarlinePainter(const LayoutConstPtr &layout,
         myX -= 2;
     }
 
-    myBounds = QRectF(0, 0, layout->getPositionSpacing(),
-                      layout->getStaffHeight());
+    myBounds = QRectF(0, 0, layout.getPositionSpacing(),
+                      layout.getStaffHeight());
 }
 
 bool
@@ -79,8 +79,8 @@ BarlinePainter::filterMousePosition(const QPointF &pos) const
 {
     // Only allow clicking within the standard notation staff.
     const double y = pos.y();
-    return (y <= myLayout->getBottomStdNotationLine()) &&
-           (y >= myLayout->getTopStdNotationLine());
+    return (y <= myGeometry.getBottomStdNotationLine()) &&
+           (y >= myGeometry.getTopStdNotationLine());
 }
 
 void
@@ -97,8 +97,8 @@ BarlinePainter::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
     // For the start bar, draw a line connecting the staves.
     if (myBarline.getPosition() == 0 && barType == Barline::SingleBar)
     {
-        painter->drawLine(QLineF(myX, myLayout->getBottomStdNotationLine(), myX,
-                                 myLayout->getTopTabLine()));
+        painter->drawLine(QLineF(myX, myGeometry.getBottomStdNotationLine(),
+                                 myX, myGeometry.getTopTabLine()));
     }
 
     if (barType == Barline::FreeTimeBar)
@@ -113,7 +113,7 @@ BarlinePainter::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
         painter->setFont(repeatFont);
 
         const QString message = QString::number(myBarline.getRepeatCount()) + "x";
-        painter->drawText(3, myLayout->getTopStdNotationLine() - 3, message);
+        painter->drawText(3, myGeometry.getTopStdNotationLine() - 3, message);
     }
 
     // Draw a single bar line.
@@ -143,25 +143,25 @@ BarlinePainter::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
         const double centreStaffLine = 3;
 
         // Draw dots for standard notation staff, on either side of the centre.
-        height = (myLayout->getStdNotationLine(centreStaffLine) +
-                  myLayout->getStdNotationLine(centreStaffLine + 1)) / 2.0;
+        height = (myGeometry.getStdNotationLine(centreStaffLine) +
+                  myGeometry.getStdNotationLine(centreStaffLine + 1)) / 2.0;
         painter->drawRect(QRectF(dotLocation, height, radius, radius));
 
-        height = (myLayout->getStdNotationLine(centreStaffLine) +
-                  myLayout->getStdNotationLine(centreStaffLine - 1)) / 2.0;
+        height = (myGeometry.getStdNotationLine(centreStaffLine) +
+                  myGeometry.getStdNotationLine(centreStaffLine - 1)) / 2.0;
         painter->drawRect(QRectF(dotLocation, height, radius, radius));
 
         // Offset the repeat dots 2 lines from the edge of the tab staff if
         // we have a large number of strings, otherwise, only offset by 1 line.
-        const int offsetFromEdge = (myLayout->getStringCount() > 4) ? 2 : 1;
+        const int offsetFromEdge = (myGeometry.getStringCount() > 4) ? 2 : 1;
 
         // Draw dots for tab staff.
-        height = (myLayout->getTabLine(offsetFromEdge) +
-                  myLayout->getTabLine(offsetFromEdge + 1)) / 2.0;
+        height = (myGeometry.getTabLine(offsetFromEdge) +
+                  myGeometry.getTabLine(offsetFromEdge + 1)) / 2.0;
         painter->drawRect(QRectF(dotLocation, height, radius, radius));
 
-        height = (myLayout->getTabLine(myLayout->getStringCount() - offsetFromEdge) +
-                  myLayout->getTabLine(myLayout->getStringCount() - offsetFromEdge + 1)) / 2.0;
+        height = (myGeometry.getTabLine(myGeometry.getStringCount() - offsetFromEdge) +
+                  myGeometry.getTabLine(myGeometry.getStringCount() - offsetFromEdge + 1)) / 2.0;
         painter->drawRect(QRectF(dotLocation, height, radius, radius));
     }
 }
@@ -171,10 +171,10 @@ void BarlinePainter::drawVerticalLines(QPainter *painter, double x)
     QVector<QLineF> lines(2);
 
     // Draw a single bar line.
-    lines[0] = QLineF(x, myLayout->getTopStdNotationLine() + 1,
-                      x, myLayout->getBottomStdNotationLine());
-    lines[1] = QLineF(x, myLayout->getTopTabLine() + 1,
-                      x, myLayout->getBottomTabLine());
+    lines[0] = QLineF(x, myGeometry.getTopStdNotationLine() + 1,
+                      x, myGeometry.getBottomStdNotationLine());
+    lines[1] = QLineF(x, myGeometry.getTopTabLine() + 1,
+                      x, myGeometry.getBottomTabLine());
 
     painter->drawLines(lines);
 }
@@ -23,15 +23,15 @@
 #include <QGraphicsItem>
 #include <memory>
 #include <painters/layoutinfo.h>
+#include <score/barline.h>
 #include <score/scorelocation.h>
 
-class Barline;
 class ScoreClickEvent;
 
 class BarlinePainter : public ClickableItem
 {
 public:
-    BarlinePainter(const LayoutConstPtr &layout, const Barline &barline,
+    BarlinePainter(const LayoutInfo &layout, const Barline &barline,
                    const ConstScoreLocation &location,
                    const ScoreClickEvent &click_event,
                    const QColor &barlineColor);
@@ -51,8 +51,10 @@ protected:
 private:
     void drawVerticalLines(QPainter *painter, double myX);
 
-    LayoutConstPtr myLayout;
-    const Barline &myBarline;
+    const StaffGeometry myGeometry;
+    /// A copy of the barline, since the system's data may be reallocated
+    /// while this item is still in the scene.
+    const Barline myBarline;
     QRectF myBounds;
     double myX;
     double myWidth;
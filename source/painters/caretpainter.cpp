@@ -21,6 +21,7 @@
 
 #include <app/caret.h>
 #include <app/viewoptions.h>
+#include <painters/layoutcache.h>
 #include <painters/layoutinfo.h>
 #include <QGraphicsScene>
 #include <QGraphicsView>
@@ -34,10 +35,11 @@ const double CaretPainter::PEN_WIDTH = 0.75;
 const double CaretPainter::CARET_NOTE_SPACING = 6;
 
 CaretPainter::CaretPainter(const Caret &caret, const ViewOptions &view_options,
-                           const QPalette &palette)
+                           const QPalette &palette, LayoutCache &layout_cache)
     : myCaret(caret),
       myViewOptions(view_options),
       myPalette(palette),
+      myLayoutCache(layout_cache),
       myCaretConnection(
           caret.subscribeToChanges([this]() { onLocationChanged(); }))
 {
@@ -170,7 +172,7 @@ void CaretPainter::onLocationChanged()
     if (system.getStaves().empty())
         return;
 
-    myLayout = std::make_unique<LayoutInfo>(location);
+    myLayout = myLayoutCache.getLayout(location);
 
     const ViewFilter *filter = myViewOptions.getFilter(location.getScore());
 
@@ -183,7 +185,8 @@ void CaretPainter::onLocationChanged()
         {
             ScoreLocation staff_location(location);
             staff_location.setStaffIndex(i);
-            offset += LayoutInfo(staff_location).getStaffHeight();
+            offset +=
+                myLayoutCache.getLayout(staff_location)->getStaffHeight();
         }
     }
 
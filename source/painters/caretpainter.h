@@ -23,6 +23,7 @@
 #include <QGraphicsItem>
 
 class Caret;
+class LayoutCache;
 struct LayoutInfo;
 class ViewOptions;
 
@@ -30,7 +31,7 @@ class CaretPainter : public QGraphicsItem
 {
 public:
     CaretPainter(const Caret &caret, const ViewOptions &view_options,
-                 const QPalette &palette);
+                 const QPalette &palette, LayoutCache &layout_cache);
 
     virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *,
                        QWidget *) override;
@@ -55,7 +56,8 @@ private:
     const Caret &myCaret;
     const ViewOptions &myViewOptions;
     const QPalette &myPalette;
-    std::unique_ptr<LayoutInfo> myLayout;
+    LayoutCache &myLayoutCache;
+    std::shared_ptr<const LayoutInfo> myLayout;
     std::vector<QRectF> mySystemRects;
     boost::signals2::scoped_connection myCaretConnection;
     LocationChangedSlot onMyLocationChanged;
@@ -0,0 +1,34 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "imageitem.h"
+
+#include <QPainter>
+
+ImageItem::ImageItem(const QImage &image, const QSizeF &size)
+    : myImage(image.scaled(static_cast<int>(size.width()),
+                           static_cast<int>(size.height()),
+                           Qt::IgnoreAspectRatio, Qt::SmoothTransformation)),
+      myBoundingRect(QPointF(0, 0), myImage.size())
+{
+}
+
+void ImageItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *,
+                      QWidget *)
+{
+    painter->drawImage(QPointF(0, 0), myImage);
+}
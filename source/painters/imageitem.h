@@ -0,0 +1,44 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PAINTERS_IMAGEITEM_H
+#define PAINTERS_IMAGEITEM_H
+
+#include <QGraphicsItem>
+#include <QImage>
+
+/// Replacement for QGraphicsPixmapItem that draws a QImage. Unlike QPixmap,
+/// QImage can be used outside of the GUI thread, so this is safe to create
+/// and paint when systems are rendered on worker threads.
+class ImageItem : public QGraphicsItem
+{
+public:
+    /// Displays the image, scaled to the given size.
+    ImageItem(const QImage &image, const QSizeF &size);
+
+    virtual QRectF boundingRect() const override { return myBoundingRect; }
+
+    virtual void paint(QPainter *painter,
+                       const QStyleOptionGraphicsItem *option,
+                       QWidget *widget) override;
+
+private:
+    const QImage myImage;
+    const QRectF myBoundingRect;
+};
+
+#endif
@@ -26,20 +26,19 @@
 #include <score/keysignature.h>
 #include <score/staff.h>
 
-KeySignaturePainter::KeySignaturePainter(const LayoutConstPtr &layout,
+KeySignaturePainter::KeySignaturePainter(const LayoutInfo &layout,
                                          const KeySignature &key,
                                          const ConstScoreLocation &location,
                                          const ScoreClickEvent &click_event)
     : ClickableItem(QCoreApplication::translate(
                         "ScoreArea", "Double-click to edit key signature."),
                     click_event, location, ScoreItem::KeySignature),
-      myLayout(layout),
       myKeySignature(key),
       myMusicFont(MusicFont::getFont(MusicFont::DEFAULT_FONT_SIZE)),
       myBounds(0, -10, LayoutInfo::getWidth(myKeySignature),
-               layout->getStdNotationStaffHeight())
+               layout.getStdNotationStaffHeight())
 {
-    initAccidentalPositions();
+    initAccidentalPositions(layout);
 }
 
 void
@@ -58,11 +57,12 @@ KeySignaturePainter::paint(QPainter *painter,
         drawAccidentals(myFlatPositions, MusicSymbol::AccidentalFlat, painter);
 }
 
-void KeySignaturePainter::adjustHeightOffset(QVector<double> &lst)
+void KeySignaturePainter::adjustHeightOffset(const LayoutInfo &layout,
+                                             QVector<double> &lst)
 {
     for (auto &elem : lst)
     {
-        elem -= myLayout->getTopStdNotationLine();
+        elem -= layout.getTopStdNotationLine();
     }
 }
 
@@ -81,7 +81,7 @@ void KeySignaturePainter::drawAccidentals(QVector<double> &positions,
     }
 }
 
-void KeySignaturePainter::initAccidentalPositions()
+void KeySignaturePainter::initAccidentalPositions(const LayoutInfo &layout)
 {
     myFlatPositions.resize(7);
     mySharpPositions.resize(7);
@@ -93,22 +93,22 @@ void KeySignaturePainter::initAccidentalPositions()
     }
 
     // Generate the positions for the key signature accidentals.
-    myFlatPositions.replace(0, myLayout->getStdNotationLine(3 + clefOffset));
-    myFlatPositions.replace(1, myLayout->getStdNotationSpace(1 + clefOffset));
-    myFlatPositions.replace(2, myLayout->getStdNotationSpace(3 + clefOffset));
-    myFlatPositions.replace(3, myLayout->getStdNotationLine(2 + clefOffset));
-    myFlatPositions.replace(4, myLayout->getStdNotationLine(4 + clefOffset));
-    myFlatPositions.replace(5, myLayout->getStdNotationSpace(2 + clefOffset));
-    myFlatPositions.replace(6, myLayout->getStdNotationSpace(4 + clefOffset));
+    myFlatPositions.replace(0, layout.getStdNotationLine(3 + clefOffset));
+    myFlatPositions.replace(1, layout.getStdNotationSpace(1 + clefOffset));
+    myFlatPositions.replace(2, layout.getStdNotationSpace(3 + clefOffset));
+    myFlatPositions.replace(3, layout.getStdNotationLine(2 + clefOffset));
+    myFlatPositions.replace(4, layout.getStdNotationLine(4 + clefOffset));
+    myFlatPositions.replace(5, layout.getStdNotationSpace(2 + clefOffset));
+    myFlatPositions.replace(6, layout.getStdNotationSpace(4 + clefOffset));
 
-    mySharpPositions.replace(0, myLayout->getStdNotationLine(1 + clefOffset));
-    mySharpPositions.replace(1, myLayout->getStdNotationSpace(2 + clefOffset));
-    mySharpPositions.replace(2, myLayout->getStdNotationSpace(0 + clefOffset));
-    mySharpPositions.replace(3, myLayout->getStdNotationLine(2 + clefOffset));
-    mySharpPositions.replace(4, myLayout->getStdNotationSpace(3 + clefOffset));
-    mySharpPositions.replace(5, myLayout->getStdNotationSpace(1 + clefOffset));
-    mySharpPositions.replace(6, myLayout->getStdNotationLine(3 + clefOffset));
+    mySharpPositions.replace(0, layout.getStdNotationLine(1 + clefOffset));
+    mySharpPositions.replace(1, layout.getStdNotationSpace(2 + clefOffset));
+    mySharpPositions.replace(2, layout.getStdNotationSpace(0 + clefOffset));
+    mySharpPositions.replace(3, layout.getStdNotationLine(2 + clefOffset));
+    mySharpPositions.replace(4, layout.getStdNotationSpace(3 + clefOffset));
+    mySharpPositions.replace(5, layout.getStdNotationSpace(1 + clefOffset));
+    mySharpPositions.replace(6, layout.getStdNotationLine(3 + clefOffset));
 
-    adjustHeightOffset(myFlatPositions);
-    adjustHeightOffset(mySharpPositions);
+    adjustHeightOffset(layout, myFlatPositions);
+    adjustHeightOffset(layout, mySharpPositions);
 }
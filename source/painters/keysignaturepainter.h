@@ -24,6 +24,7 @@
 #include <QFont>
 #include <QGraphicsItem>
 #include <painters/layoutinfo.h>
+#include <score/keysignature.h>
 #include <score/scorelocation.h>
 
 class ScoreClickEvent;
@@ -31,7 +32,7 @@ class ScoreClickEvent;
 class KeySignaturePainter : public ClickableItem
 {
 public:
-    KeySignaturePainter(const LayoutConstPtr &layout, const KeySignature &key,
+    KeySignaturePainter(const LayoutInfo &layout, const KeySignature &key,
                         const ConstScoreLocation &location,
                         const ScoreClickEvent &click_event);
 
@@ -43,17 +44,16 @@ public:
     }
 
 private:
-    LayoutConstPtr myLayout;
-    const KeySignature &myKeySignature;
+    const KeySignature myKeySignature;
     QFont myMusicFont;
     const QRectF myBounds;
     QVector<double> myFlatPositions;
     QVector<double> mySharpPositions;
 
-    void adjustHeightOffset(QVector<double> &lst);
+    void adjustHeightOffset(const LayoutInfo &layout, QVector<double> &lst);
     void drawAccidentals(QVector<double> &positions, QChar accidental,
                          QPainter *painter);
-    void initAccidentalPositions();
+    void initAccidentalPositions(const LayoutInfo &layout);
 };
 
 #endif
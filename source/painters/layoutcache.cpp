@@ -0,0 +1,67 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "layoutcache.h"
+
+#include <score/scorelocation.h>
+#include <score/system.h>
+
+LayoutConstPtr LayoutCache::getLayout(const ConstScoreLocation &location)
+{
+    const size_t system = location.getSystemIndex();
+    const size_t staff = location.getStaffIndex();
+    const uint64_t generation = location.getSystem().getGeneration();
+
+    {
+        std::lock_guard lock(myMutex);
+        if (system < myLayouts.size() && staff < myLayouts[system].size())
+        {
+            const Entry &entry = myLayouts[system][staff];
+            if (entry.myLayout && entry.myGeneration == generation)
+                return entry.myLayout;
+        }
+    }
+
+    // Compute the layout without holding the lock, so that other threads
+    // aren't blocked. If two threads race to compute the same layout, the
+    // results are identical so it doesn't matter which one is stored.
+    auto layout = std::make_shared<const LayoutInfo>(location);
+
+    std::lock_guard lock(myMutex);
+    if (system >= myLayouts.size())
+        myLayouts.resize(system + 1);
+
+    std::vector<Entry> &staves = myLayouts[system];
+    if (staff >= staves.size())
+        staves.resize(staff + 1);
+
+    staves[staff] = { generation, layout };
+    return layout;
+}
+
+void LayoutCache::invalidateSystem(int system)
+{
+    std::lock_guard lock(myMutex);
+    if (system >= 0 && system < static_cast<int>(myLayouts.size()))
+        myLayouts[system].clear();
+}
+
+void LayoutCache::clear()
+{
+    std::lock_guard lock(myMutex);
+    myLayouts.clear();
+}
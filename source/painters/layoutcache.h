@@ -0,0 +1,62 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PAINTERS_LAYOUTCACHE_H
+#define PAINTERS_LAYOUTCACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <painters/layoutinfo.h>
+#include <vector>
+
+class ConstScoreLocation;
+
+/// Stores the layout of each staff in the score, so that it can be shared by
+/// the system renderer and the caret rather than being recomputed.
+/// The layout of a staff does not depend on the view filter (which only
+/// controls which staves are drawn), so entries are keyed by the system and
+/// staff index. Any edits to a system must invalidate its entries.
+/// A layout refers to the data of the system it was computed from, so entries
+/// are also discarded if the system has since been given a new copy of its
+/// data (see System::getGeneration()).
+/// This can be safely accessed from multiple rendering threads.
+class LayoutCache
+{
+public:
+    /// Returns the layout for the location's staff, computing it if
+    /// necessary.
+    LayoutConstPtr getLayout(const ConstScoreLocation &location);
+
+    /// Discards the layouts for all staves in the system.
+    void invalidateSystem(int system);
+
+    /// Discards all cached layouts.
+    void clear();
+
+private:
+    struct Entry
+    {
+        /// The generation of the system's data that the layout refers to.
+        uint64_t myGeneration = 0;
+        LayoutConstPtr myLayout;
+    };
+
+    std::mutex myMutex;
+    std::vector<std::vector<Entry>> myLayouts;
+};
+
+#endif
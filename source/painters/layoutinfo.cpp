@@ -918,3 +918,52 @@ int SymbolGroup::getHeight() const
 {
     return myHeight;
 }
+
+StaffGeometry::StaffGeometry(const LayoutInfo &layout)
+    : myStringCount(layout.getStringCount()),
+      myTopStdNotationLine(layout.getTopStdNotationLine()),
+      myTopTabLine(layout.getTopTabLine()),
+      myTabLineSpacing(layout.getTabLineSpacing())
+{
+}
+
+int StaffGeometry::getStringCount() const
+{
+    return myStringCount;
+}
+
+double StaffGeometry::getStdNotationLine(int line) const
+{
+    return myTopStdNotationLine +
+           (line - 1) * LayoutInfo::STD_NOTATION_LINE_SPACING;
+}
+
+double StaffGeometry::getTopStdNotationLine() const
+{
+    return myTopStdNotationLine;
+}
+
+double StaffGeometry::getBottomStdNotationLine() const
+{
+    return getStdNotationLine(LayoutInfo::NUM_STD_NOTATION_LINES);
+}
+
+double StaffGeometry::getTabLine(int line) const
+{
+    return myTopTabLine + (line - 1) * myTabLineSpacing;
+}
+
+double StaffGeometry::getTopTabLine() const
+{
+    return myTopTabLine;
+}
+
+double StaffGeometry::getBottomTabLine() const
+{
+    return getTabLine(myStringCount);
+}
+
+double StaffGeometry::getTabLineSpacing() const
+{
+    return myTabLineSpacing;
+}
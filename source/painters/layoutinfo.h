@@ -97,6 +97,9 @@ private:
     int myHeight;
 };
 
+/// The layout of a staff. This refers to the data of the system that it was
+/// computed from, so items in the scene should copy what they need from it
+/// (e.g. StaffGeometry) rather than keeping the layout.
 struct LayoutInfo
 {
     LayoutInfo(const ConstScoreLocation &location);
@@ -236,6 +239,32 @@ private:
     std::array<std::vector<NoteStem>, Staff::NUM_VOICES> myStems;
 };
 
+/// A copy of a staff's line positions from its layout. Unlike LayoutInfo, this
+/// does not refer to the score, so items in the scene can keep it after the
+/// system's data is modified or unshared.
+class StaffGeometry
+{
+public:
+    explicit StaffGeometry(const LayoutInfo &layout);
+
+    int getStringCount() const;
+
+    double getStdNotationLine(int line) const;
+    double getTopStdNotationLine() const;
+    double getBottomStdNotationLine() const;
+
+    double getTabLine(int line) const;
+    double getTopTabLine() const;
+    double getBottomTabLine() const;
+    double getTabLineSpacing() const;
+
+private:
+    int myStringCount;
+    double myTopStdNotationLine;
+    double myTopTabLine;
+    double myTabLineSpacing;
+};
+
 typedef std::shared_ptr<LayoutInfo> LayoutPtr;
 typedef std::shared_ptr<const LayoutInfo> LayoutConstPtr;
 
@@ -0,0 +1,217 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "scoreprinter.h"
+
+#include <painters/chorddiagrampainter.h>
+#include <painters/layoutinfo.h>
+#include <painters/scoreinforenderer.h>
+#include <painters/systemrenderer.h>
+#include <QGraphicsItem>
+#include <QImage>
+#include <QPagedPaintDevice>
+#include <QPainter>
+#include <QPalette>
+#include <QStyleOptionGraphicsItem>
+#include <score/score.h>
+#include <util/parallelfor.h>
+
+ScorePrinter::ScorePrinter(const Score &score, const ViewOptions &view_options,
+                           LayoutCache &layout_cache, const QPalette &palette,
+                           double system_spacing)
+    : myBackgroundColor(palette.base().color())
+{
+    const QColor color = palette.text().color();
+    myItems.emplace_back(ScoreInfoRenderer::render(score, color, myClickEvent));
+    myItems.emplace_back(ChordDiagramPainter::renderDiagrams(
+        score, color, myClickEvent, LayoutInfo::STAFF_WIDTH));
+
+    const int num_systems = static_cast<int>(score.getSystems().size());
+    myItems.resize(2 + num_systems);
+    Util::parallelFor(num_systems, [&](int i) {
+        SystemRenderer render(score, view_options, layout_cache, palette,
+                              myClickEvent);
+        myItems[2 + i].reset(render(score.getSystems()[i], i));
+    });
+
+    // Position the items in the same way as the score area.
+    double height = 0;
+    for (size_t i = 0; i < myItems.size(); ++i)
+    {
+        myItems[i]->setPos(0, height);
+        height += myItems[i]->boundingRect().height() +
+                  (i < 2 ? 0.5 * system_spacing : system_spacing);
+    }
+}
+
+ScorePrinter::~ScorePrinter() = default;
+
+void ScorePrinter::print(QPagedPaintDevice &device) const
+{
+    const std::vector<Page> pages =
+        layoutPages(QSizeF(device.width(), device.height()));
+
+    // Painting onto a single device can't be split across threads, so the
+    // pages are drawn in order.
+    QPainter painter(&device);
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        if (i > 0)
+            device.newPage();
+
+        paintPage(painter, pages[i]);
+    }
+}
+
+std::vector<QImage> ScorePrinter::renderPages(const QSize &image_size,
+                                              const QMargins &margins) const
+{
+    const QRect page_rect = QRect(QPoint(0, 0), image_size) - margins;
+    const std::vector<Page> pages = layoutPages(page_rect.size());
+
+    // Each item only appears on one page, so the pages can be drawn at the
+    // same time.
+    std::vector<QImage> images(pages.size());
+    Util::parallelFor(static_cast<int>(pages.size()), [&](int i) {
+        QImage image(image_size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(myBackgroundColor);
+
+        QPainter painter(&image);
+        painter.setRenderHints(QPainter::Antialiasing |
+                               QPainter::TextAntialiasing |
+                               QPainter::SmoothPixmapTransform);
+        painter.translate(page_rect.topLeft());
+        paintPage(painter, pages[i]);
+        painter.end();
+
+        images[i] = std::move(image);
+    });
+
+    return images;
+}
+
+std::vector<ScorePrinter::Page>
+ScorePrinter::layoutPages(const QSizeF &page_size) const
+{
+    std::vector<Page> pages(1);
+
+    // Scale the score based on the ratio between the page's width and our
+    // normal staff width in the UI.
+    QRectF target_rect(QPointF(0, 0), page_size);
+    const double ratio = target_rect.width() / LayoutInfo::STAFF_WIDTH;
+
+    for (size_t i = 0; i < myItems.size(); ++i)
+    {
+        QGraphicsItem *item = myItems[i].get();
+        const QRectF source_rect = item->sceneBoundingRect();
+        // Skip if e.g. the score info block is completely empty to avoid
+        // division by zero and other issues.
+        if (source_rect.height() == 0.0)
+            continue;
+
+        if (i > 0)
+        {
+            const double spacing =
+                source_rect.y() - myItems[i - 1]->sceneBoundingRect().bottom();
+            target_rect.moveTop(target_rect.y() + spacing * ratio);
+        }
+
+        // Figure out how much space the item will take up on the page, and
+        // determine if we need a page break. An item that is taller than the
+        // page is placed on the current page if it is still empty.
+        const double height = source_rect.height() * ratio;
+        if (target_rect.y() + height > page_size.height() &&
+            !pages.back().empty())
+        {
+            pages.emplace_back();
+            target_rect.moveTop(0);
+        }
+
+        target_rect.setLeft(source_rect.left() * ratio);
+        target_rect.setWidth(source_rect.width() * ratio);
+        target_rect.setHeight(height);
+        pages.back().push_back({ item, source_rect, target_rect });
+
+        // Set the location for the next item.
+        target_rect.moveTop(target_rect.y() + height);
+    }
+
+    return pages;
+}
+
+/// Returns whether the item is drawn before its parent.
+static bool isBehindParent(const QGraphicsItem &item)
+{
+    return item.zValue() < 0 ||
+           item.flags().testFlag(QGraphicsItem::ItemStacksBehindParent);
+}
+
+/// Draws the item and its children, in the same order as a QGraphicsScene.
+/// The transform maps scene coordinates to the page.
+static void paintItem(QPainter &painter, const QTransform &transform,
+                      QGraphicsItem &item)
+{
+    if (!item.isVisible())
+        return;
+
+    const QList<QGraphicsItem *> children = item.childItems();
+    for (QGraphicsItem *child : children)
+    {
+        if (isBehindParent(*child))
+            paintItem(painter, transform, *child);
+    }
+
+    if (!item.flags().testFlag(QGraphicsItem::ItemHasNoContents))
+    {
+        QStyleOptionGraphicsItem option;
+        option.exposedRect = item.boundingRect();
+        option.rect = option.exposedRect.toAlignedRect();
+
+        painter.save();
+        painter.setTransform(item.sceneTransform() * transform, true);
+        painter.setOpacity(item.effectiveOpacity());
+        item.paint(&painter, &option);
+        painter.restore();
+    }
+
+    for (QGraphicsItem *child : children)
+    {
+        if (!isBehindParent(*child))
+            paintItem(painter, transform, *child);
+    }
+}
+
+void ScorePrinter::paintPage(QPainter &painter, const Page &page)
+{
+    for (const PageItem &page_item : page)
+    {
+        const QRectF &source = page_item.mySourceRect;
+        const QRectF &target = page_item.myTargetRect;
+
+        // Map the item's scene coordinates onto its location on the page.
+        const double ratio = target.height() / source.height();
+        QTransform transform;
+        transform.translate(target.left(), target.top());
+        transform.scale(ratio, ratio);
+        transform.translate(-source.left(), -source.top());
+
+        painter.save();
+        painter.setClipRect(target, Qt::IntersectClip);
+        paintItem(painter, transform, *page_item.myItem);
+        painter.restore();
+    }
+}
@@ -0,0 +1,89 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PAINTERS_SCOREPRINTER_H
+#define PAINTERS_SCOREPRINTER_H
+
+#include <memory>
+#include <painters/scoreclickevent.h>
+#include <QColor>
+#include <QMargins>
+#include <QRectF>
+#include <vector>
+
+class LayoutCache;
+class QGraphicsItem;
+class QImage;
+class QPagedPaintDevice;
+class QPainter;
+class QPalette;
+class QSize;
+class QSizeF;
+class Score;
+class ViewOptions;
+
+/// Lays out a score into pages for printing or exporting (e.g. to PDF or
+/// images).
+/// The score is rendered into a separate set of items rather than using the
+/// score area's scene, so the on-screen view is left untouched and this can
+/// also be used without any user interface.
+class ScorePrinter
+{
+public:
+    /// Renders the score's systems in parallel, using the given colors and
+    /// the spacing between systems.
+    ScorePrinter(const Score &score, const ViewOptions &view_options,
+                 LayoutCache &layout_cache, const QPalette &palette,
+                 double system_spacing);
+    ~ScorePrinter();
+
+    ScorePrinter(const ScorePrinter &) = delete;
+    ScorePrinter &operator=(const ScorePrinter &) = delete;
+
+    /// Prints each page to a device such as a QPrinter or QPdfWriter.
+    void print(QPagedPaintDevice &device) const;
+
+    /// Renders each page to an image of the given size, with the score
+    /// inset by the margins. The pages are rendered in parallel.
+    std::vector<QImage> renderPages(const QSize &image_size,
+                                    const QMargins &margins = {}) const;
+
+private:
+    /// An item to be drawn at a location on the page.
+    struct PageItem
+    {
+        QGraphicsItem *myItem;
+        QRectF mySourceRect;
+        QRectF myTargetRect;
+    };
+
+    using Page = std::vector<PageItem>;
+
+    /// Splits the items into pages of the given size.
+    std::vector<Page> layoutPages(const QSizeF &page_size) const;
+
+    /// Draws the items on the page.
+    static void paintPage(QPainter &painter, const Page &page);
+
+    /// The rendered items refer to this, but nothing listens for clicks.
+    ScoreClickEvent myClickEvent;
+    QColor myBackgroundColor;
+    /// The score information, chord diagrams and then each system.
+    std::vector<std::unique_ptr<QGraphicsItem>> myItems;
+};
+
+#endif
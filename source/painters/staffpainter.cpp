@@ -23,16 +23,19 @@
 #include <QGraphicsSceneMouseEvent>
 #include <QPainter>
 
-StaffPainter::StaffPainter(const LayoutConstPtr &layout,
+StaffPainter::StaffPainter(const LayoutInfo &layout,
                            const ConstScoreLocation &location,
                            const ScoreClickEvent &click_event,
                            const QColor staffColor)
-    : myLayout(layout),
+    : myGeometry(layout),
       myClickEvent(click_event),
       myLocation(location),
-      myBounds(0, 0, LayoutInfo::STAFF_WIDTH, layout->getStaffHeight()),
+      myBounds(0, 0, LayoutInfo::STAFF_WIDTH, layout.getStaffHeight()),
       myStaffColor(staffColor)
 {
+    for (int i = 0; i < layout.getNumPositions(); ++i)
+        myPositionX.push_back(layout.getPositionX(i));
+
     // Only use the left mouse button for making selections.
     setAcceptedMouseButtons(Qt::LeftButton);
 }
@@ -44,12 +47,12 @@ void StaffPainter::mousePressEvent(QGraphicsSceneMouseEvent *event)
 
     // Find the position relative to the top of the staff, in terms of the tab
     // line spacing. Then, round it to find the string index.
-    const int string = std::floor(((y - myLayout->getTopTabLine()) /
-                                   myLayout->getTabLineSpacing()) + 0.5);
+    const int string = std::floor(((y - myGeometry.getTopTabLine()) /
+                                   myGeometry.getTabLineSpacing()) + 0.5);
 
-    if (string >= 0 && string < myLayout->getStringCount())
+    if (string >= 0 && string < myGeometry.getStringCount())
     {
-        const int position = myLayout->getPositionFromX(x);
+        const int position = getPositionFromX(x);
         myLocation.setPositionIndex(position);
         myLocation.setSelectionStart(position);
         myLocation.setString(string);
@@ -62,7 +65,7 @@ void StaffPainter::mousePressEvent(QGraphicsSceneMouseEvent *event)
 void StaffPainter::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
 {
     const double x = event->pos().x();
-    myLocation.setPositionIndex(myLayout->getPositionFromX(x));
+    myLocation.setPositionIndex(getPositionFromX(x));
     myClickEvent.signal(ScoreItem::Staff, myLocation,
                         ScoreItemAction::Selected);
 }
@@ -75,12 +78,29 @@ void StaffPainter::paint(QPainter *painter, const QStyleOptionGraphicsItem *,
 
     // Draw standard notation staff.
     drawStaffLines(painter, LayoutInfo::NUM_STD_NOTATION_LINES,
-                   myLayout->STD_NOTATION_LINE_SPACING,
-                   myLayout->getTopStdNotationLine());
+                   LayoutInfo::STD_NOTATION_LINE_SPACING,
+                   myGeometry.getTopStdNotationLine());
 
     // Draw tab staff.
-    drawStaffLines(painter, myLayout->getStringCount(),
-                   myLayout->getTabLineSpacing(), myLayout->getTopTabLine());
+    drawStaffLines(painter, myGeometry.getStringCount(),
+                   myGeometry.getTabLineSpacing(), myGeometry.getTopTabLine());
+}
+
+int StaffPainter::getPositionFromX(double x) const
+{
+    // This matches LayoutInfo::getPositionFromX().
+    if (myPositionX.empty() || myPositionX.front() >= x)
+        return 0;
+
+    const int maxPosition = static_cast<int>(myPositionX.size()) - 1;
+
+    for (int i = 1; i <= maxPosition; ++i)
+    {
+        if (myPositionX[i] >= x)
+            return i - 1;
+    }
+
+    return maxPosition;
 }
 
 void StaffPainter::drawStaffLines(QPainter *painter, int lineCount,
@@ -22,6 +22,7 @@
 #include <painters/layoutinfo.h>
 #include <QGraphicsItem>
 #include <score/scorelocation.h>
+#include <vector>
 
 class ScoreClickEvent;
 class Staff;
@@ -29,7 +30,7 @@ class Staff;
 class StaffPainter : public QGraphicsItem
 {
 public:
-    StaffPainter(const LayoutConstPtr &layout,
+    StaffPainter(const LayoutInfo &layout,
                  const ConstScoreLocation &location,
                  const ScoreClickEvent &click_event,
                  const QColor staffColor);
@@ -51,7 +52,9 @@ private:
                         double startHeight);
     int getPositionFromX(double x) const;
 
-    LayoutConstPtr myLayout;
+    const StaffGeometry myGeometry;
+    /// The x-coordinate of each position in the staff.
+    std::vector<double> myPositionX;
     const ScoreClickEvent &myClickEvent;
     ConstScoreLocation myLocation;
     const QRectF myBounds;
@@ -22,7 +22,9 @@
 #include <painters/antialiasedpathitem.h>
 #include <painters/barlinepainter.h>
 #include <painters/clickableitem.h>
+#include <painters/imageitem.h>
 #include <painters/keysignaturepainter.h>
+#include <painters/layoutcache.h>
 #include <painters/layoutinfo.h>
 #include <painters/simpletextitem.h>
 #include <painters/staffpainter.h>
@@ -57,11 +59,15 @@ void SystemRenderer::centerSymbolVertically(QGraphicsItem &item, double y)
                          item.boundingRect().height()));
 }
 
-SystemRenderer::SystemRenderer(const ScoreArea *score_area, const Score &score,
-                               const ViewOptions &view_options)
-    : myScoreArea(score_area),
-      myScore(score),
+SystemRenderer::SystemRenderer(const Score &score,
+                               const ViewOptions &view_options,
+                               LayoutCache &layout_cache,
+                               const QPalette &palette,
+                               const ScoreClickEvent &click_event)
+    : myScore(score),
       myViewOptions(view_options),
+      myLayoutCache(layout_cache),
+      myClickEvent(click_event),
       myParentSystem(nullptr),
       myParentStaff(nullptr),
       myMusicNotationFont(MusicFont::getFont(MusicFont::DEFAULT_FONT_SIZE)),
@@ -75,7 +81,7 @@ SystemRenderer::SystemRenderer(const ScoreArea *score_area, const Score &score,
     mySymbolTextFont.setPixelSize(9);
     myRehearsalSignFont.setPixelSize(12);
 
-    myPalette = *myScoreArea->getPalette();
+    myPalette = palette;
 }
 
 QGraphicsItem *SystemRenderer::operator()(const System &system,
@@ -100,7 +106,7 @@ QGraphicsItem *SystemRenderer::operator()(const System &system,
 
         const bool isFirstStaff = (height == 0);
         const ConstScoreLocation location(myScore, systemIndex, i);
-        LayoutConstPtr layout = std::make_shared<LayoutInfo>(location);
+        LayoutConstPtr layout = myLayoutCache.getLayout(location);
 
         if (isFirstStaff)
         {
@@ -128,7 +134,7 @@ QGraphicsItem *SystemRenderer::operator()(const System &system,
                     b2*avgWeight+b1*(1-avgWeight));
 
         myParentStaff = new StaffPainter(
-            layout, location, myScoreArea->getClickEvent(), staffColor);
+            *layout, location, myClickEvent, staffColor);
         myParentStaff->setPos(0, height);
         myParentStaff->setParentItem(myParentSystem);
         height += layout->getStaffHeight();
@@ -148,7 +154,7 @@ QGraphicsItem *SystemRenderer::operator()(const System &system,
                                clef_font, TextAlignment::Baseline, QPen(myPalette.text().color()));
         auto group = new ClickableGroup(
             ScoreArea::tr("Double-click to change clef type."),
-            myScoreArea->getClickEvent(), location, ScoreItem::Clef);
+            myClickEvent, location, ScoreItem::Clef);
         group->addToGroup(clef);
         group->setPos(LayoutInfo::CLEF_PADDING, clef_y);
         group->setParentItem(myParentStaff);
@@ -175,6 +181,33 @@ QGraphicsItem *SystemRenderer::operator()(const System &system,
     return myParentSystem;
 }
 
+QGraphicsItem *SystemRenderer::createPlaceholder(const System &system,
+                                                 int systemIndex)
+{
+    auto placeholder = new QGraphicsRectItem();
+    placeholder->setPen(QPen(myPalette.text(), 0.5));
+
+    const ViewFilter *filter = myViewOptions.getFilter(myScore);
+
+    // This must match the staff heights used in operator().
+    double height = 0;
+    for (int i = 0, n = static_cast<int>(system.getStaves().size()); i < n;
+         ++i)
+    {
+        if (filter && !filter->accept(myScore, systemIndex, i))
+            continue;
+
+        LayoutConstPtr layout = myLayoutCache.getLayout(
+            ConstScoreLocation(myScore, systemIndex, i));
+        if (height == 0)
+            height += layout->getSystemSymbolSpacing();
+        height += layout->getStaffHeight();
+    }
+
+    placeholder->setRect(0, 0, LayoutInfo::STAFF_WIDTH, height);
+    return placeholder;
+}
+
 void SystemRenderer::drawTabClef(double x, const LayoutInfo &layout,
                                  const ConstScoreLocation &location)
 {
@@ -190,7 +223,7 @@ void SystemRenderer::drawTabClef(double x, const LayoutInfo &layout,
 
     auto group = new ClickableGroup(
         ScoreArea::tr("Double-click to edit the number of strings."),
-        myScoreArea->getClickEvent(), location, ScoreItem::Clef);
+        myClickEvent, location, ScoreItem::Clef);
     group->addToGroup(clef);
 
     // Position the clef symbol. The middle of the 'A' is aligned with the
@@ -227,7 +260,7 @@ SystemRenderer::drawBarlines(const ConstScoreLocation &location,
         const TimeSignature &timeSig = barline.getTimeSignature();
 
         BarlinePainter *barlinePainter = new BarlinePainter(
-            layout, barline, bar_location, myScoreArea->getClickEvent(),
+            *layout, barline, bar_location, myClickEvent,
             myPalette.text().color());
 
         double x = layout->getPositionX(barline.getPosition());
@@ -274,7 +307,7 @@ SystemRenderer::drawBarlines(const ConstScoreLocation &location,
         if (keySig.isVisible())
         {
             auto keySigPainter = new KeySignaturePainter(
-                layout, keySig, bar_location, myScoreArea->getClickEvent());
+                *layout, keySig, bar_location, myClickEvent);
 
             keySigPainter->setPos(keySigX, layout->getTopStdNotationLine());
             keySigPainter->setParentItem(myParentStaff);
@@ -283,7 +316,7 @@ SystemRenderer::drawBarlines(const ConstScoreLocation &location,
         if (timeSig.isVisible())
         {
             auto timeSigPainter = new TimeSignaturePainter(
-                layout, timeSig, bar_location, myScoreArea->getClickEvent());
+                *layout, timeSig, bar_location, myClickEvent);
 
             timeSigPainter->setPos(timeSigX, layout->getTopStdNotationLine());
             timeSigPainter->setParentItem(myParentStaff);
@@ -296,7 +329,7 @@ SystemRenderer::drawBarlines(const ConstScoreLocation &location,
 
             auto group = new ClickableGroup(
                 ScoreArea::tr("Double-click to edit rehearsal sign."),
-                myScoreArea->getClickEvent(), bar_location,
+                myClickEvent, bar_location,
                 ScoreItem::RehearsalSign);
 
             auto signLetters = new SimpleTextItem(
@@ -498,7 +531,7 @@ SystemRenderer::drawAlternateEndings(const ConstScoreLocation &location,
 
         auto group = new ClickableGroup(
             ScoreArea::tr("Double-click to edit repeat endings."),
-            myScoreArea->getClickEvent(), ending_location,
+            myClickEvent, ending_location,
             ScoreItem::AlternateEnding);
 
         // Draw the vertical line.
@@ -632,7 +665,7 @@ SystemRenderer::drawTempoMarkers(const ConstScoreLocation &location,
 
         auto group = new ClickableGroup(
             ScoreArea::tr("Double-click to edit tempo marker."),
-            myScoreArea->getClickEvent(), marker_location,
+            myClickEvent, marker_location,
             tempo.getMarkerType() == TempoMarker::AlterationOfPace
                 ? ScoreItem::AlterationOfPace
                 : ScoreItem::TempoMarker);
@@ -659,27 +692,28 @@ SystemRenderer::drawTempoMarkers(const ConstScoreLocation &location,
 
             // Add the beat type image.
             QFontMetricsF fm(font);
-            QPixmap image(getBeatTypeImage(tempo.getBeatType()));
+            // Convert the image in the same way as QPixmap, since e.g. an
+            // indexed image can't be recolored.
+            QImage image = QImage(getBeatTypeImage(tempo.getBeatType()))
+                               .convertToFormat(
+                                   QImage::Format_ARGB32_Premultiplied);
 
             //set the color of the beat type image according to theme
-            QImage tmp = image.toImage();
             QColor color(myPalette.text().color());
-            for(int y = 0; y < tmp.height(); y++)
+            for(int y = 0; y < image.height(); y++)
             {
-                for(int x= 0; x < tmp.width(); x++)
+                for(int x= 0; x < image.width(); x++)
                 {
-                    color.setAlpha(tmp.pixelColor(x,y).alpha());
-                    tmp.setPixelColor(x,y,color);
+                    color.setAlpha(image.pixelColor(x,y).alpha());
+                    image.setPixelColor(x,y,color);
                 }
             }
-            image = QPixmap::fromImage(tmp);
 
-            auto pixmap = new QGraphicsPixmapItem(image.scaled(
-                fm.horizontalAdvance(imageSpacing), NOTE_HEIGHT,
-                Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-            pixmap->setX(fm.horizontalAdvance(text));
-            centerSymbolVertically(*pixmap, height);
-            group->addToGroup(pixmap);
+            auto imageItem = new ImageItem(
+                image, QSizeF(fm.horizontalAdvance(imageSpacing), NOTE_HEIGHT));
+            imageItem->setX(fm.horizontalAdvance(text));
+            centerSymbolVertically(*imageItem, height);
+            group->addToGroup(imageItem);
 
             text += imageSpacing;
             text += QStringLiteral(" = ");
@@ -687,13 +721,13 @@ SystemRenderer::drawTempoMarkers(const ConstScoreLocation &location,
             if (tempo.getMarkerType() == TempoMarker::ListessoMarker)
             {
                 // Add the second beat type image.
-                QPixmap image(getBeatTypeImage(tempo.getListessoBeatType()));
-                auto pixmap = new QGraphicsPixmapItem(image.scaled(
-                    fm.horizontalAdvance(imageSpacing), NOTE_HEIGHT,
-                    Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-                pixmap->setX(fm.horizontalAdvance(text));
-                centerSymbolVertically(*pixmap, height);
-                group->addToGroup(pixmap);
+                QImage image(getBeatTypeImage(tempo.getListessoBeatType()));
+                auto imageItem = new ImageItem(
+                    image,
+                    QSizeF(fm.horizontalAdvance(imageSpacing), NOTE_HEIGHT));
+                imageItem->setX(fm.horizontalAdvance(text));
+                centerSymbolVertically(*imageItem, height);
+                group->addToGroup(imageItem);
 
                 text += imageSpacing;
             }
@@ -706,13 +740,12 @@ SystemRenderer::drawTempoMarkers(const ConstScoreLocation &location,
                 text += QStringLiteral(" ( ");
 
                 const QString imageSpacing(12, ' ');
-                QPixmap image(getTripletFeelImage(tempo));
-                pixmap = new QGraphicsPixmapItem(image.scaled(
-                    fm.horizontalAdvance(imageSpacing), 21,
-                    Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-                pixmap->setX(fm.horizontalAdvance(text));
-                centerSymbolVertically(*pixmap, height);
-                group->addToGroup(pixmap);
+                QImage image(getTripletFeelImage(tempo));
+                imageItem = new ImageItem(
+                    image, QSizeF(fm.horizontalAdvance(imageSpacing), 21));
+                imageItem->setX(fm.horizontalAdvance(text));
+                centerSymbolVertically(*imageItem, height);
+                group->addToGroup(imageItem);
 
                 text += imageSpacing + " )";
             }
@@ -739,7 +772,7 @@ SystemRenderer::drawChordText(const ConstScoreLocation &location,
 
         auto group = new ClickableGroup(
             ScoreArea::tr("Double-click to edit chord text."),
-            myScoreArea->getClickEvent(), item_location, ScoreItem::ChordText);
+            myClickEvent, item_location, ScoreItem::ChordText);
 
         const std::string text = chord.getChordName().getDescription();
         auto textItem = new SimpleTextItem(QString::fromStdString(text),
@@ -765,7 +798,7 @@ SystemRenderer::drawTextItems(const ConstScoreLocation &location,
 
         auto group = new ClickableGroup(
             ScoreArea::tr("Double-click to edit text."),
-            myScoreArea->getClickEvent(), item_location, ScoreItem::TextItem);
+            myClickEvent, item_location, ScoreItem::TextItem);
 
         // Note: the SimpleTextItem class is not used here since multi-line
         // support is needed.
@@ -935,7 +968,7 @@ SystemRenderer::drawPlayerChanges(const ConstScoreLocation &location,
 
         auto group = new ClickableGroup(
             ScoreArea::tr("Double-click to edit the active players."),
-            myScoreArea->getClickEvent(), change_location,
+            myClickEvent, change_location,
             ScoreItem::PlayerChange);
 
         QString description;
@@ -1387,7 +1420,7 @@ SystemRenderer::createVolumeSwell(const ConstScoreLocation &location,
 
     auto path_item = new ClickableItemT<QGraphicsPathItem>(
         ScoreArea::tr("Double-click to edit volume swell."),
-        myScoreArea->getClickEvent(), swell_location, ScoreItem::VolumeSwell);
+        myClickEvent, swell_location, ScoreItem::VolumeSwell);
     path_item->setPath(path);
     path_item->setPen(myPalette.text().color());
     return path_item;
@@ -1407,7 +1440,7 @@ SystemRenderer::createTremoloBar(const ConstScoreLocation &location,
 
     auto group = new ClickableGroup(
         ScoreArea::tr("Double-click to edit tremolo bar."),
-        myScoreArea->getClickEvent(), trem_location, ScoreItem::TremoloBar);
+        myClickEvent, trem_location, ScoreItem::TremoloBar);
 
     double x_start = 0;
     double x_end = symbol_group.getWidth();
@@ -1581,7 +1614,7 @@ SystemRenderer::createDynamic(const ConstScoreLocation &location,
 
     auto group = new ClickableGroup(
         ScoreArea::tr("Double-click to edit dynamic."),
-        myScoreArea->getClickEvent(), item_location, ScoreItem::Dynamic);
+        myClickEvent, item_location, ScoreItem::Dynamic);
     group->addToGroup(textItem);
     return group;
 }
@@ -1924,7 +1957,7 @@ SystemRenderer::drawMultiBarRest(const ConstScoreLocation &location,
 
     auto group = new ClickableGroup(
         ScoreArea::tr("Double-click to edit multi-bar rest."),
-        myScoreArea->getClickEvent(), location, ScoreItem::MultiBarRest);
+        myClickEvent, location, ScoreItem::MultiBarRest);
 
     // Draw the measure count.
     auto measureCountText = new SimpleTextItem(
@@ -2176,7 +2209,7 @@ SystemRenderer::createBendGroup(const ConstScoreLocation &location,
 
             auto bend_group = new ClickableGroup(
                 ScoreArea::tr("Double-click to edit bend."),
-                myScoreArea->getClickEvent(), bend_location, ScoreItem::Bend);
+                myClickEvent, bend_location, ScoreItem::Bend);
 
             const Bend &bend = note.getBend();
             const Bend::BendType type = bend.getType();
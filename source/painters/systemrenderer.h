@@ -25,11 +25,12 @@
 #include <score/staff.h>
 #include <QPalette>
 
+class LayoutCache;
 class QGraphicsItem;
 class QGraphicsItemGroup;
 class QGraphicsRectItem;
 class Score;
-class ScoreArea;
+class ScoreClickEvent;
 class ScoreLocation;
 class System;
 class ViewOptions;
@@ -37,11 +38,17 @@ class ViewOptions;
 class SystemRenderer
 {
 public:
-    SystemRenderer(const ScoreArea *score_area, const Score &score,
-                   const ViewOptions &view_options);
+    SystemRenderer(const Score &score, const ViewOptions &view_options,
+                   LayoutCache &layout_cache, const QPalette &palette,
+                   const ScoreClickEvent &click_event);
 
     QGraphicsItem *operator()(const System &system, int systemIndex);
 
+    /// Creates an empty outline for the system, with the same size as the
+    /// fully rendered system. This only requires the staff layouts to be
+    /// computed, so it is much cheaper than rendering the system.
+    QGraphicsItem *createPlaceholder(const System &system, int systemIndex);
+
 private:
     /// Draws the tab clef.
     void drawTabClef(double x, const LayoutInfo &layout,
@@ -204,9 +211,10 @@ private:
     void drawSlide(const LayoutInfo &layout, int string, bool slideUp,
                    int position1, int position2) const;
 
-    const ScoreArea *myScoreArea;
     const Score &myScore;
     const ViewOptions &myViewOptions;
+    LayoutCache &myLayoutCache;
+    const ScoreClickEvent &myClickEvent;
 
     QGraphicsRectItem *myParentSystem;
     QGraphicsItem *myParentStaff;
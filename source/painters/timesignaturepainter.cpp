@@ -23,17 +23,16 @@
 #include <QPainter>
 #include <score/timesignature.h>
 
-TimeSignaturePainter::TimeSignaturePainter(const LayoutConstPtr &layout,
+TimeSignaturePainter::TimeSignaturePainter(const LayoutInfo &layout,
                                            const TimeSignature &time,
                                            const ConstScoreLocation &location,
                                            const ScoreClickEvent &click_event)
     : ClickableItem(QCoreApplication::translate(
                         "ScoreArea", "Click to edit time signature."),
                     click_event, location, ScoreItem::TimeSignature),
-      myLayout(layout),
       myTimeSignature(time),
       myBounds(0, 0, LayoutInfo::getWidth(myTimeSignature),
-               myLayout->getStdNotationStaffHeight())
+               layout.getStdNotationStaffHeight())
 {
 }
 
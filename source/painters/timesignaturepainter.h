@@ -24,14 +24,14 @@
 #include <painters/layoutinfo.h>
 #include <QGraphicsItem>
 #include <score/scorelocation.h>
+#include <score/timesignature.h>
 
 class ScoreClickEvent;
-class TimeSignature;
 
 class TimeSignaturePainter : public ClickableItem
 {
 public:
-    TimeSignaturePainter(const LayoutConstPtr &layout,
+    TimeSignaturePainter(const LayoutInfo &layout,
                          const TimeSignature &time,
                          const ConstScoreLocation &location,
                          const ScoreClickEvent &click_event);
@@ -47,8 +47,7 @@ public:
 private:
     void drawNumber(QPainter* painter, const double y, const int number) const;
 
-    LayoutConstPtr myLayout;
-    const TimeSignature &myTimeSignature;
+    const TimeSignature myTimeSignature;
     const QRectF myBounds;
 };
 
@@ -0,0 +1,234 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "binaryserialization.h"
+
+#include <atomic>
+#include "serialization.h"
+#include <util/readall.h>
+
+namespace ScoreUtils::detail
+{
+/// Identifies the binary format at the start of the data.
+static constexpr std::string_view theMagic = "PT2B";
+
+size_t
+nextEnumTypeIndex()
+{
+    static std::atomic<size_t> theNextIndex = 0;
+    return theNextIndex++;
+}
+
+BinaryInputArchive::BinaryInputArchive(std::istream &is)
+{
+    if (!is)
+        throw std::runtime_error("Could not open stream");
+
+    myData = Util::readAll(is);
+
+    if (myData.compare(0, theMagic.size(), theMagic) != 0)
+        throw std::runtime_error("Not a binary Power Tab file");
+    myPosition = theMagic.size();
+
+    // Since fields are not labelled, there's no way to read a newer file
+    // version.
+    const uint64_t version = readVarint();
+    if (version < static_cast<uint64_t>(FileVersion::INITIAL_VERSION) ||
+        version > static_cast<uint64_t>(FileVersion::LATEST_VERSION))
+    {
+        throw std::runtime_error("Unsupported file version: " +
+                                 std::to_string(version));
+    }
+
+    myVersion = static_cast<FileVersion>(version);
+}
+
+FileVersion
+BinaryInputArchive::version() const
+{
+    return myVersion;
+}
+
+uint8_t
+BinaryInputArchive::readByte()
+{
+    if (myPosition >= myData.size())
+        throw std::runtime_error("Unexpected end of file");
+
+    return static_cast<uint8_t>(myData[myPosition++]);
+}
+
+uint64_t
+BinaryInputArchive::readVarint()
+{
+    uint64_t val = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        const uint8_t byte = readByte();
+        val |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80))
+            return val;
+    }
+
+    throw std::runtime_error("Invalid varint");
+}
+
+int64_t
+BinaryInputArchive::readSigned()
+{
+    const uint64_t val = readVarint();
+    return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+}
+
+uint32_t
+BinaryInputArchive::readLength()
+{
+    uint32_t length = 0;
+    for (int i = 0; i < 4; ++i)
+        length |= static_cast<uint32_t>(readByte()) << (8 * i);
+
+    if (length > myData.size() - myPosition)
+        throw std::runtime_error("Unexpected end of file");
+
+    return length;
+}
+
+size_t
+BinaryInputArchive::readSize()
+{
+    // Every item takes at least one byte, so this guards against allocating
+    // huge arrays for a corrupt file.
+    const uint64_t size = readVarint();
+    if (size > myData.size() - myPosition)
+        throw std::runtime_error("Invalid size");
+
+    return static_cast<size_t>(size);
+}
+
+void
+BinaryInputArchive::read(bool &val)
+{
+    val = readByte() != 0;
+}
+
+void
+BinaryInputArchive::read(std::string &str)
+{
+    const size_t length = readSize();
+    str.assign(myData, myPosition, length);
+    myPosition += length;
+}
+
+void
+BinaryInputArchive::read(Util::Date &date)
+{
+    int year = 0, month = 0, day = 0;
+    read(year);
+    read(month);
+    read(day);
+    date = Util::Date(year, month, day);
+}
+
+BinaryOutputArchive::BinaryOutputArchive(FileVersion version)
+    : myVersion(version)
+{
+    myData.append(theMagic);
+    writeVarint(static_cast<uint64_t>(version));
+}
+
+const std::string &
+BinaryOutputArchive::data() const
+{
+    return myData;
+}
+
+void
+BinaryOutputArchive::writeByte(uint8_t val)
+{
+    myData.push_back(static_cast<char>(val));
+}
+
+void
+BinaryOutputArchive::writeVarint(uint64_t val)
+{
+    while (val >= 0x80)
+    {
+        writeByte(static_cast<uint8_t>(val | 0x80));
+        val >>= 7;
+    }
+
+    writeByte(static_cast<uint8_t>(val));
+}
+
+void
+BinaryOutputArchive::writeSigned(int64_t val)
+{
+    // Zigzag encoding, so that small negative numbers are also small.
+    writeVarint((static_cast<uint64_t>(val) << 1) ^
+                static_cast<uint64_t>(val >> 63));
+}
+
+void
+BinaryOutputArchive::writeString(std::string_view str)
+{
+    writeVarint(str.size());
+    myData.append(str);
+}
+
+void
+BinaryOutputArchive::writeEnum(size_t type_index, int value,
+                               std::string_view text)
+{
+    // Define a new tag.
+    writeVarint(0);
+    writeString(text);
+
+    const uint32_t tag = ++myNextEnumTag;
+    if (value < 0)
+        return;
+
+    if (type_index >= myEnumTags.size())
+        myEnumTags.resize(type_index + 1);
+
+    std::vector<uint32_t> &tags = myEnumTags[type_index];
+    if (static_cast<size_t>(value) >= tags.size())
+        tags.resize(value + 1, 0);
+
+    tags[value] = tag;
+}
+
+void
+BinaryOutputArchive::write(bool val)
+{
+    writeByte(val ? 1 : 0);
+}
+
+void
+BinaryOutputArchive::write(const std::string &str)
+{
+    writeString(str);
+}
+
+void
+BinaryOutputArchive::write(const Util::Date &date)
+{
+    write(date.year());
+    write(date.month());
+    write(date.day());
+}
+} // namespace ScoreUtils::detail
@@ -0,0 +1,448 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCORE_BINARYSERIALIZATION_H
+#define SCORE_BINARYSERIALIZATION_H
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include "fileversion.h"
+#include <iostream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <util/date.h>
+#include <util/enumflags.h>
+#include <util/enumtostring_fwd.h>
+#include <vector>
+
+/// A compact binary encoding for the same serialize() functions that are used
+/// for the JSON format.
+///
+/// Fields are stored in the order that serialize() visits them, without their
+/// names, so a file can only be read by the code for its own file version or
+/// a newer one. This relies on serialize() only adding or removing fields
+/// based on the file version, which is already required for the JSON format.
+///
+/// - Integers are stored as varints, using zigzag encoding for signed values.
+/// - Enums are stored as tags that are defined by their string value the
+///   first time they are used, which keeps files valid if the enum values
+///   are reordered.
+/// - Each element of an array of objects (e.g. each system) is prefixed by
+///   its size in bytes, so that it can be skipped over or read separately.
+namespace ScoreUtils
+{
+namespace detail
+{
+    /// Returns a unique index for each enum type.
+    size_t nextEnumTypeIndex();
+
+    template <typename EnumT>
+    size_t getEnumTypeIndex()
+    {
+        static const size_t index = nextEnumTypeIndex();
+        return index;
+    }
+
+    class BinaryInputArchive
+    {
+    public:
+        static constexpr bool IsLoading = true;
+
+        BinaryInputArchive(std::istream &is);
+
+        /// The version of the file being read.
+        FileVersion version() const;
+
+        template <typename T>
+        void operator()(const std::string_view &, T &obj)
+        {
+            read(obj);
+        }
+
+    private:
+        uint8_t readByte();
+        uint64_t readVarint();
+        int64_t readSigned();
+        uint32_t readLength();
+        size_t readSize();
+        /// Reads an enum tag, and returns the enum value that it refers to, if
+        /// the value is known.
+        template <typename EnumT>
+        std::optional<EnumT> readEnum();
+
+        void read(bool &val);
+        void read(std::string &str);
+        void read(Util::Date &date);
+
+        template <typename T>
+        void read(std::vector<T> &vec);
+
+        template <typename K, typename V, typename C>
+        void read(std::map<K, V, C> &map);
+
+        template <typename T, size_t N>
+        void read(std::array<T, N> &arr);
+
+        template <typename EnumT>
+        void read(Util::EnumFlags<EnumT> &flags);
+
+        template <typename T>
+        void read(std::optional<T> &val);
+
+        template <typename T>
+        void read(T &val)
+        {
+            if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                const int64_t int_val = readSigned();
+                if (int_val < std::numeric_limits<T>::min() ||
+                    int_val > std::numeric_limits<T>::max())
+                {
+                    throw std::overflow_error("Invalid integer value");
+                }
+
+                val = static_cast<T>(int_val);
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                const uint64_t int_val = readVarint();
+                if (int_val > std::numeric_limits<T>::max())
+                    throw std::overflow_error("Invalid integer value");
+
+                val = static_cast<T>(int_val);
+            }
+            else if constexpr (std::is_same_v<T, FileVersion>)
+                val = static_cast<FileVersion>(readVarint());
+            else if constexpr (std::is_enum_v<T>)
+            {
+                if (auto result = readEnum<T>())
+                    val = *result;
+            }
+            else if constexpr (std::is_class_v<T>)
+                val.serialize(*this, myVersion);
+            else
+                assert(false);
+        }
+
+        std::string myData;
+        size_t myPosition = 0;
+        FileVersion myVersion;
+
+        struct EnumTag
+        {
+            /// The enum type that the tag was defined for.
+            size_t myTypeIndex;
+            /// The enum value, or -1 if the value is unknown (e.g. from a
+            /// newer file version).
+            int myValue;
+        };
+
+        /// The tags that have been defined.
+        std::vector<EnumTag> myEnumTags;
+    };
+
+    class BinaryOutputArchive
+    {
+    public:
+        static constexpr bool IsLoading = false;
+
+        BinaryOutputArchive(FileVersion version);
+
+        template <typename T>
+        void operator()(const std::string_view &, const T &obj)
+        {
+            write(obj);
+        }
+
+        /// The encoded data.
+        const std::string &data() const;
+
+    private:
+        void writeByte(uint8_t val);
+        void writeVarint(uint64_t val);
+        void writeSigned(int64_t val);
+        void writeString(std::string_view str);
+        void writeEnum(size_t type_index, int value, std::string_view text);
+
+        void write(bool val);
+        void write(const std::string &str);
+        void write(const Util::Date &date);
+
+        template <typename T>
+        void write(const std::vector<T> &vec);
+
+        template <typename K, typename V, typename C>
+        void write(const std::map<K, V, C> &map);
+
+        template <typename T, size_t N>
+        void write(const std::array<T, N> &arr);
+
+        template <typename EnumT>
+        void write(const Util::EnumFlags<EnumT> &flags);
+
+        template <typename T>
+        void write(const std::optional<T> &val);
+
+        template <typename T>
+        void write(const T &obj)
+        {
+            if constexpr (std::is_integral_v<T>)
+            {
+                if constexpr (std::is_signed_v<T>)
+                    writeSigned(obj);
+                else
+                    writeVarint(obj);
+            }
+            else if constexpr (std::is_same_v<T, FileVersion>)
+                writeVarint(static_cast<uint64_t>(obj));
+            else if constexpr (std::is_enum_v<T>)
+            {
+                const int value = static_cast<int>(obj);
+                const size_t type_index = getEnumTypeIndex<T>();
+
+                // Only look up the string for the first use of the value.
+                if (type_index < myEnumTags.size() &&
+                    static_cast<size_t>(value) < myEnumTags[type_index].size() &&
+                    myEnumTags[type_index][value] != 0)
+                {
+                    writeVarint(myEnumTags[type_index][value]);
+                }
+                else
+                    writeEnum(type_index, value, Util::enumToString(obj));
+            }
+            else // score objects.
+                const_cast<T &>(obj).serialize(*this, myVersion);
+        }
+
+        const FileVersion myVersion;
+        std::string myData;
+
+        /// For each enum type and value, the tag that was written for it plus
+        /// one, or zero if no tag has been defined yet.
+        std::vector<std::vector<uint32_t>> myEnumTags;
+        uint32_t myNextEnumTag = 0;
+    };
+
+    template <typename EnumT>
+    std::optional<EnumT> BinaryInputArchive::readEnum()
+    {
+        // A tag of zero defines a new tag, followed by the enum's string
+        // value.
+        const uint64_t tag = readVarint();
+        const size_t type_index = getEnumTypeIndex<EnumT>();
+        if (tag == 0)
+        {
+            std::string text;
+            read(text);
+
+            auto value = Util::toEnum<EnumT>(text);
+            if (!value)
+                std::cerr << "Unknown enum value: " << text << std::endl;
+
+            myEnumTags.push_back(
+                { type_index, value ? static_cast<int>(*value) : -1 });
+            return value;
+        }
+
+        // In a corrupt file, the tag might have been defined for a different
+        // enum type, in which case its value may not be valid for this type.
+        if (tag > myEnumTags.size() ||
+            myEnumTags[tag - 1].myTypeIndex != type_index)
+        {
+            throw std::runtime_error("Invalid enum tag");
+        }
+
+        const int value = myEnumTags[tag - 1].myValue;
+        if (value < 0)
+            return std::nullopt;
+
+        return static_cast<EnumT>(value);
+    }
+
+    template <typename T>
+    void BinaryInputArchive::read(std::vector<T> &vec)
+    {
+        vec.resize(readSize());
+
+        for (T &obj : vec)
+        {
+            if constexpr (std::is_class_v<T> && !std::is_same_v<T, std::string>)
+            {
+                const uint32_t length = readLength();
+                const size_t end = myPosition + length;
+
+                read(obj);
+                if (myPosition != end)
+                    throw std::runtime_error("Invalid object size");
+            }
+            else
+                read(obj);
+        }
+    }
+
+    template <typename K, typename V, typename C>
+    void BinaryInputArchive::read(std::map<K, V, C> &map)
+    {
+        for (size_t i = 0, n = readSize(); i < n; ++i)
+        {
+            K key;
+            read(key);
+
+            V val;
+            read(val);
+            map[key] = val;
+        }
+    }
+
+    template <typename T, size_t N>
+    void BinaryInputArchive::read(std::array<T, N> &arr)
+    {
+        if (readSize() != N)
+            throw std::runtime_error("Invalid array size");
+
+        for (T &obj : arr)
+            read(obj);
+    }
+
+    template <typename EnumT>
+    void BinaryInputArchive::read(Util::EnumFlags<EnumT> &flags)
+    {
+        for (size_t i = 0, n = readSize(); i < n; ++i)
+        {
+            // Ignore any unknown flags from future file versions.
+            if (auto flag = readEnum<EnumT>())
+                flags.setFlag(*flag, true);
+        }
+    }
+
+    template <typename T>
+    void BinaryInputArchive::read(std::optional<T> &val)
+    {
+        if (readByte() == 0)
+            val.reset();
+        else
+        {
+            T data;
+            read(data);
+            val = data;
+        }
+    }
+
+    template <typename T>
+    void BinaryOutputArchive::write(const std::vector<T> &vec)
+    {
+        writeVarint(vec.size());
+
+        for (const T &obj : vec)
+        {
+            if constexpr (std::is_class_v<T> && !std::is_same_v<T, std::string>)
+            {
+                // Reserve space for the size, and fill it in afterwards.
+                const size_t start = myData.size();
+                myData.append(4, '\0');
+
+                write(obj);
+
+                const size_t length = myData.size() - start - 4;
+                if (length > std::numeric_limits<uint32_t>::max())
+                    throw std::length_error("Object is too large");
+
+                for (size_t i = 0; i < 4; ++i)
+                    myData[start + i] = static_cast<char>(length >> (8 * i));
+            }
+            else
+                write(obj);
+        }
+    }
+
+    template <typename K, typename V, typename C>
+    void BinaryOutputArchive::write(const std::map<K, V, C> &map)
+    {
+        writeVarint(map.size());
+
+        for (auto &&[key, value] : map)
+        {
+            write(key);
+            write(value);
+        }
+    }
+
+    template <typename T, size_t N>
+    void BinaryOutputArchive::write(const std::array<T, N> &arr)
+    {
+        writeVarint(N);
+
+        for (const T &obj : arr)
+            write(obj);
+    }
+
+    template <typename EnumT>
+    void BinaryOutputArchive::write(const Util::EnumFlags<EnumT> &flags)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < Util::EnumFlags<EnumT>::NumFlags; ++i)
+        {
+            if (flags.getFlag(static_cast<EnumT>(i)))
+                ++count;
+        }
+
+        writeVarint(count);
+
+        for (size_t i = 0; i < Util::EnumFlags<EnumT>::NumFlags; ++i)
+        {
+            auto flag = static_cast<EnumT>(i);
+            if (flags.getFlag(flag))
+                write(flag);
+        }
+    }
+
+    template <typename T>
+    void BinaryOutputArchive::write(const std::optional<T> &val)
+    {
+        writeByte(val ? 1 : 0);
+        if (val)
+            write(*val);
+    }
+} // namespace detail
+
+/// Loads an object that was saved with saveBinary().
+template <typename T>
+void
+loadBinary(std::istream &input, T &obj)
+{
+    detail::BinaryInputArchive archive(input);
+    archive("", obj);
+}
+
+/// Saves an object using the compact binary encoding.
+template <typename T>
+void
+saveBinary(std::ostream &output, const T &obj)
+{
+    detail::BinaryOutputArchive ar(FileVersion::LATEST_VERSION);
+    ar("", obj);
+
+    output.write(ar.data().data(), static_cast<std::streamsize>(ar.data().size()));
+}
+} // namespace ScoreUtils
+
+#endif
@@ -92,6 +92,9 @@ const Position *ConstScoreLocation::getPosition() const
 
 Position *ScoreLocation::getPosition()
 {
+    // Give the system its own copy of the data before handing out a writeable
+    // pointer into it.
+    getVoice();
     return const_cast<Position *>(ConstScoreLocation::getPosition());
 }
 
@@ -157,7 +160,9 @@ bool ConstScoreLocation::hasSelection() const
 
 std::vector<Position *> ScoreLocation::getSelectedPositions()
 {
-    // Avoid duplicate logic between const and non-const versions.
+    // Avoid duplicate logic between const and non-const versions, after
+    // giving the system its own copy of the data.
+    getVoice();
     auto positions = ConstScoreLocation::getSelectedPositions();
     std::vector<Position *> nc_positions;
     for (const Position *pos : positions)
@@ -246,7 +251,9 @@ Barline *ScoreLocation::getBarline()
 std::vector<Barline *>
 ScoreLocation::getSelectedBarlines()
 {
-    // Avoid duplicate logic between const and non-const versions.
+    // Avoid duplicate logic between const and non-const versions, after
+    // giving the system its own copy of the data.
+    getSystem().getBarlines();
     std::vector<const Barline *> barlines = ConstScoreLocation::getSelectedBarlines();
     std::vector<Barline *> nc_barlines;
     for (const Barline *barline : barlines)
@@ -290,12 +297,26 @@ const Note *ConstScoreLocation::getNote() const
 
 Note *ScoreLocation::getNote()
 {
+    getVoice();
     return const_cast<Note *>(ConstScoreLocation::getNote());
 }
 
 std::vector<Note *> ScoreLocation::getSelectedNotes()
 {
-    std::vector<Note *> notes;
+    // Avoid duplicate logic between const and non-const versions, after
+    // giving the system its own copy of the data.
+    getVoice();
+    auto notes = ConstScoreLocation::getSelectedNotes();
+    std::vector<Note *> nc_notes;
+    for (const Note *note : notes)
+        nc_notes.push_back(const_cast<Note *>(note));
+
+    return nc_notes;
+}
+
+std::vector<const Note *> ConstScoreLocation::getSelectedNotes() const
+{
+    std::vector<const Note *> notes;
 
     if (!hasSelection())
     {
@@ -304,10 +325,9 @@ std::vector<Note *> ScoreLocation::getSelectedNotes()
     }
     else
     {
-        std::vector<Position *> selectedPositions(getSelectedPositions());
-        for (Position *pos : selectedPositions)
+        for (const Position *pos : getSelectedPositions())
         {
-            for (Note &note : pos->getNotes())
+            for (const Note &note : pos->getNotes())
                 notes.push_back(&note);
         }
     }
@@ -79,6 +79,7 @@ public:
     void setString(int string);
 
     const Note *getNote() const;
+    std::vector<const Note *> getSelectedNotes() const;
 
     /// @{
     /// Chord diagrams are global, so they can have their own selection index.
@@ -135,6 +136,7 @@ public:
 
     using ConstScoreLocation::getNote;
     Note *getNote();
+    using ConstScoreLocation::getSelectedNotes;
     std::vector<Note *> getSelectedNotes();
 
 private:
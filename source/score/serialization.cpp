@@ -20,17 +20,229 @@
 #include <boost/date_time/gregorian/greg_date.hpp>
 #include <boost/date_time/gregorian/formatters_limited.hpp>
 #include <boost/date_time/gregorian/parsers.hpp>
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <limits>
+#include <util/readall.h>
 
 namespace ScoreUtils::detail
 {
+namespace
+{
+/// Returns true if the character ends a number or literal.
+bool isDelimiter(char c)
+{
+    switch (c)
+    {
+        case ',':
+        case ']':
+        case '}':
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// Returns true if the text is a complete literal such as "true", rather than
+/// e.g. the start of "trueish".
+bool isLiteral(std::string_view text, size_t pos, std::string_view literal)
+{
+    const size_t end = pos + literal.size();
+    return text.compare(pos, literal.size(), literal) == 0 &&
+           (end == text.size() || isDelimiter(text[end]));
+}
+
+/// Returns true if the text is a number in the JSON grammar. std::from_chars
+/// also accepts other forms such as leading zeros ("01"), ".5" or "inf".
+bool isNumber(std::string_view text)
+{
+    size_t i = 0;
+    auto skipDigits = [&]() {
+        const size_t start = i;
+        while (i < text.size() && text[i] >= '0' && text[i] <= '9')
+            ++i;
+        return i > start;
+    };
+
+    if (i < text.size() && text[i] == '-')
+        ++i;
+
+    // The integer part is either 0 or starts with a non-zero digit.
+    if (i < text.size() && text[i] == '0')
+        ++i;
+    else if (!skipDigits())
+        return false;
+
+    if (i < text.size() && text[i] == '.')
+    {
+        ++i;
+        if (!skipDigits())
+            return false;
+    }
+
+    if (i < text.size() && (text[i] == 'e' || text[i] == 'E'))
+    {
+        ++i;
+        if (i < text.size() && (text[i] == '+' || text[i] == '-'))
+            ++i;
+        if (!skipDigits())
+            return false;
+    }
+
+    return i == text.size();
+}
+
+/// Parses the four hex digits of a \u escape sequence.
+uint32_t parseCodeUnit(std::string_view text, size_t pos)
+{
+    uint32_t value = 0;
+    if (pos + 4 > text.size() ||
+        std::from_chars(text.data() + pos, text.data() + pos + 4, value, 16)
+                .ptr != text.data() + pos + 4)
+    {
+        throw std::runtime_error("Invalid unicode escape sequence");
+    }
+
+    return value;
+}
+
+/// Returns the offset just after the string starting at the given offset,
+/// and checks that it only contains valid escape sequences and no control
+/// characters.
+size_t checkString(std::string_view text, size_t pos)
+{
+    for (++pos; pos < text.size(); ++pos)
+    {
+        const char c = text[pos];
+        if (c == '"')
+            return pos + 1;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            throw std::runtime_error("Invalid control character in string");
+        else if (c != '\\')
+            continue;
+
+        if (++pos == text.size())
+            break;
+
+        switch (text[pos])
+        {
+            case '"':
+            case '\\':
+            case '/':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+                break;
+            case 'u':
+            {
+                const uint32_t code_unit = parseCodeUnit(text, pos + 1);
+                pos += 4;
+
+                // A high surrogate must be followed by a low surrogate, and a
+                // low surrogate can't appear on its own.
+                if (code_unit >= 0xD800 && code_unit <= 0xDBFF)
+                {
+                    if (text.compare(pos + 1, 2, "\\u") != 0)
+                        throw std::runtime_error("Invalid surrogate pair");
+
+                    const uint32_t low = parseCodeUnit(text, pos + 3);
+                    if (low < 0xDC00 || low > 0xDFFF)
+                        throw std::runtime_error("Invalid surrogate pair");
+
+                    pos += 6;
+                }
+                else if (code_unit >= 0xDC00 && code_unit <= 0xDFFF)
+                    throw std::runtime_error("Invalid surrogate pair");
+
+                break;
+            }
+            default:
+                throw std::runtime_error("Invalid escape sequence");
+        }
+    }
+
+    throw std::runtime_error("Unterminated string");
+}
+
+/// Returns the offset just after the number or literal at the given offset,
+/// and checks that it is valid.
+size_t checkScalar(std::string_view text, size_t pos)
+{
+    const size_t start = pos;
+    while (pos < text.size() && !isDelimiter(text[pos]))
+        ++pos;
+
+    const std::string_view token = text.substr(start, pos - start);
+    if (token.empty())
+        throw std::runtime_error("Expected a value");
+
+    if (token != "true" && token != "false" && token != "null" &&
+        !isNumber(token))
+    {
+        throw std::runtime_error("Invalid value");
+    }
+
+    return pos;
+}
+
+void appendUtf8(std::string &str, uint32_t code_point)
+{
+    if (code_point < 0x80)
+        str += static_cast<char>(code_point);
+    else if (code_point < 0x800)
+    {
+        str += static_cast<char>(0xC0 | (code_point >> 6));
+        str += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+    else if (code_point < 0x10000)
+    {
+        str += static_cast<char>(0xE0 | (code_point >> 12));
+        str += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+    else
+    {
+        str += static_cast<char>(0xF0 | (code_point >> 18));
+        str += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        str += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+}
+} // namespace
+
 InputArchive::InputArchive(std::istream &is)
 {
     if (!is)
         throw std::runtime_error("Could not open stream");
 
-    is >> myDocument;
-    myValueStack.push(&myDocument);
+    myDocument = std::make_shared<Document>();
+    myDocument->myText = Util::readAll(is);
+    myText = myDocument->myText;
+
+    // Skip a UTF-8 byte order mark.
+    size_t start = 0;
+    if (myText.compare(0, 3, "\xEF\xBB\xBF") == 0)
+        start = 3;
+
+    start = skipWhitespace(start);
+    if (start == myText.size())
+        throw std::runtime_error("Unexpected end of input");
+
+    indexContainers(start);
+
+    size_t next_container = 0;
+    const Value root = getValue(start, next_container);
+    if (skipWhitespace(getEnd(root)) != myText.size())
+        throw std::runtime_error("Unexpected data after the root value");
+
+    pushValue(root);
 
     int version = 0;
     (*this)("version", version);
@@ -51,11 +263,443 @@ InputArchive::InputArchive(std::istream &is)
     }
 }
 
+InputArchive::InputArchive(const InputArchive &parent, Value value)
+    : myDocument(parent.myDocument),
+      myText(parent.myText),
+      myVersion(parent.myVersion),
+      myIsWorker(true)
+{
+    pushValue(value);
+}
+
 FileVersion InputArchive::version() const
 {
     return myVersion;
 }
 
+void
+InputArchive::indexContainers(size_t start)
+{
+    std::vector<Container> &containers = myDocument->myContainers;
+
+    // Stack of the containers that have not been closed yet.
+    std::vector<size_t> open_containers;
+
+    // Checks an object key and the ':' after it.
+    auto checkKey = [&](size_t pos) {
+        if (peek(pos) != '"')
+            throw std::runtime_error("Expected an object key");
+
+        pos = skipWhitespace(checkString(myText, pos));
+        if (peek(pos) != ':')
+            throw std::runtime_error("Expected ':'");
+
+        return skipWhitespace(pos + 1);
+    };
+
+    size_t pos = start;
+    bool expect_value = true;
+    while (true)
+    {
+        if (expect_value)
+        {
+            const char c = peek(pos);
+            if (c == '{' || c == '[')
+            {
+                open_containers.push_back(containers.size());
+                containers.push_back({ pos, 0 });
+
+                // Check for an empty container, which is closed below.
+                pos = skipWhitespace(pos + 1);
+                if (peek(pos) == (c == '{' ? '}' : ']'))
+                    expect_value = false;
+                else if (c == '{')
+                    pos = checkKey(pos);
+
+                continue;
+            }
+
+            if (c == '"')
+                pos = checkString(myText, pos);
+            else
+                pos = checkScalar(myText, pos);
+
+            expect_value = false;
+        }
+        else if (open_containers.empty())
+            return;
+        else
+        {
+            pos = skipWhitespace(pos);
+
+            // While the container is open, its end holds the offset of the
+            // opening bracket.
+            Container &container = containers[open_containers.back()];
+            const bool is_object = myText[container.myEnd] == '{';
+
+            const char c = peek(pos);
+            if (c == ',')
+            {
+                pos = skipWhitespace(pos + 1);
+                if (is_object)
+                    pos = checkKey(pos);
+
+                expect_value = true;
+            }
+            else if (c == (is_object ? '}' : ']'))
+            {
+                container.myEnd = pos + 1;
+                container.myNext = containers.size();
+                open_containers.pop_back();
+                ++pos;
+            }
+            else if (is_object)
+                throw std::runtime_error("Expected ',' or '}'");
+            else
+                throw std::runtime_error("Expected ',' or ']'");
+        }
+    }
+}
+
+const InputArchive::Value *
+InputArchive::findMember(std::string_view name)
+{
+    Frame &frame = myFrames[myDepth - 1];
+    if (peek(frame.myValue.myPosition) != '{')
+        return nullptr;
+
+    if (!frame.myIndexed)
+        indexObject(frame);
+
+    // If there are duplicate keys, the last one is used.
+    for (auto it = frame.myMembers.rbegin(); it != frame.myMembers.rend();
+         ++it)
+    {
+        std::string_view key = it->myRawKey;
+        if (key.find('\\') == std::string_view::npos)
+        {
+            if (key == name)
+                return &it->myValue;
+        }
+        else
+        {
+            const size_t key_pos = key.data() - myText.data() - 1;
+            if (parseString(key_pos) == name)
+                return &it->myValue;
+        }
+    }
+
+    return nullptr;
+}
+
+void
+InputArchive::indexObject(Frame &frame)
+{
+    frame.myIndexed = true;
+
+    size_t pos = skipWhitespace(frame.myValue.myPosition + 1);
+    if (peek(pos) == '}')
+        return;
+
+    size_t next_container = frame.myValue.myContainer + 1;
+    while (true)
+    {
+        if (peek(pos) != '"')
+            throw std::runtime_error("Expected an object key");
+
+        const size_t key_end = skipString(pos);
+        std::string_view key(myText.data() + pos + 1, key_end - pos - 2);
+
+        pos = skipWhitespace(key_end);
+        if (peek(pos) != ':')
+            throw std::runtime_error("Expected ':'");
+
+        const Value value = getValue(skipWhitespace(pos + 1), next_container);
+        frame.myMembers.push_back({ key, value });
+        pos = skipWhitespace(getEnd(value));
+
+        const char c = peek(pos);
+        if (c == '}')
+            return;
+        else if (c != ',')
+            throw std::runtime_error("Expected ',' or '}'");
+
+        pos = skipWhitespace(pos + 1);
+    }
+}
+
+std::vector<InputArchive::Value>
+InputArchive::getElements()
+{
+    std::vector<Value> elements;
+    forEachElement([&]() { elements.push_back(myFrames[myDepth - 1].myValue); });
+    return elements;
+}
+
+bool
+InputArchive::shouldReadInParallel() const
+{
+    // Only split up large arrays (such as the list of systems in a score).
+    // Nested arrays are read on the same worker thread.
+    constexpr size_t min_size = 64 * 1024;
+
+    const Value &value = myFrames[myDepth - 1].myValue;
+    return !myIsWorker && value.myContainer != NO_CONTAINER &&
+           getEnd(value) - value.myPosition >= min_size;
+}
+
+void
+InputArchive::pushValue(Value value)
+{
+    if (myDepth == myFrames.size())
+        myFrames.emplace_back();
+
+    Frame &frame = myFrames[myDepth++];
+    frame.myValue = value;
+    frame.myIndexed = false;
+    frame.myMembers.clear();
+}
+
+void
+InputArchive::popValue()
+{
+    --myDepth;
+}
+
+size_t
+InputArchive::getEnd(const Value &value) const
+{
+    if (value.myContainer != NO_CONTAINER)
+        return myDocument->myContainers[value.myContainer].myEnd;
+    else
+        return skipScalar(value.myPosition);
+}
+
+InputArchive::Value
+InputArchive::getValue(size_t pos, size_t &next_container) const
+{
+    const char c = peek(pos);
+    if (c != '{' && c != '[')
+        return { pos, NO_CONTAINER };
+
+    const Value value = { pos, next_container };
+    next_container = myDocument->myContainers[next_container].myNext;
+    return value;
+}
+
+size_t
+InputArchive::skipWhitespace(size_t pos) const
+{
+    while (pos < myText.size())
+    {
+        const char c = myText[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+            break;
+
+        ++pos;
+    }
+
+    return pos;
+}
+
+size_t
+InputArchive::skipScalar(size_t pos) const
+{
+    if (peek(pos) == '"')
+        return skipString(pos);
+
+    // Numbers and literals.
+    const size_t start = pos;
+    while (pos < myText.size() && !isDelimiter(myText[pos]))
+        ++pos;
+
+    if (pos == start)
+        throw std::runtime_error("Expected a value");
+
+    return pos;
+}
+
+size_t
+InputArchive::skipString(size_t pos) const
+{
+    for (++pos; pos < myText.size(); ++pos)
+    {
+        const char c = myText[pos];
+        if (c == '"')
+            return pos + 1;
+        else if (c == '\\') // Skip the escaped character.
+            ++pos;
+    }
+
+    throw std::runtime_error("Unterminated string");
+}
+
+std::string
+InputArchive::parseString(size_t pos) const
+{
+    if (peek(pos) != '"')
+        throw std::runtime_error("Expected a string");
+
+    const size_t end = skipString(pos) - 1;
+    std::string str;
+    str.reserve(end - pos - 1);
+
+    for (size_t i = pos + 1; i < end; ++i)
+    {
+        const char c = myText[i];
+        if (c != '\\')
+        {
+            str += c;
+            continue;
+        }
+
+        switch (myText[++i])
+        {
+            case '"':
+                str += '"';
+                break;
+            case '\\':
+                str += '\\';
+                break;
+            case '/':
+                str += '/';
+                break;
+            case 'b':
+                str += '\b';
+                break;
+            case 'f':
+                str += '\f';
+                break;
+            case 'n':
+                str += '\n';
+                break;
+            case 'r':
+                str += '\r';
+                break;
+            case 't':
+                str += '\t';
+                break;
+            case 'u':
+            {
+                uint32_t code_point = parseCodeUnit(myText, i + 1);
+                i += 4;
+
+                // Combine surrogate pairs.
+                if (code_point >= 0xD800 && code_point <= 0xDBFF)
+                {
+                    if (myText.compare(i + 1, 2, "\\u") != 0)
+                        throw std::runtime_error("Invalid surrogate pair");
+
+                    const uint32_t low = parseCodeUnit(myText, i + 3);
+                    if (low < 0xDC00 || low > 0xDFFF)
+                        throw std::runtime_error("Invalid surrogate pair");
+
+                    code_point =
+                        0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                else if (code_point >= 0xDC00 && code_point <= 0xDFFF)
+                    throw std::runtime_error("Invalid surrogate pair");
+
+                appendUtf8(str, code_point);
+                break;
+            }
+            default:
+                throw std::runtime_error("Invalid escape sequence");
+        }
+    }
+
+    return str;
+}
+
+char
+InputArchive::peek(size_t pos) const
+{
+    if (pos >= myText.size())
+        throw std::runtime_error("Unexpected end of input");
+
+    return myText[pos];
+}
+
+bool
+InputArchive::isNull() const
+{
+    return isLiteral(myText, position(), "null");
+}
+
+int64_t
+InputArchive::readInteger()
+{
+    const size_t pos = position();
+    const size_t end = skipScalar(pos);
+
+    const char *first = myText.data() + pos;
+    const char *last = myText.data() + end;
+    if (!isNumber(std::string_view(first, last - first)))
+        throw std::runtime_error("Expected a number");
+
+    int64_t value = 0;
+    auto result = std::from_chars(first, last, value);
+    if (result.ec == std::errc() && result.ptr == last)
+        return value;
+
+    // Fall back to truncating a floating point value.
+    double fp_value = 0;
+    result = std::from_chars(first, last, fp_value);
+    if (result.ec == std::errc() && result.ptr == last)
+        return static_cast<int64_t>(fp_value);
+
+    throw std::runtime_error("Expected a number");
+}
+
+void
+InputArchive::read(int &val)
+{
+    val = static_cast<int>(readInteger());
+}
+
+void
+InputArchive::read(int8_t &val)
+{
+    int int_val = static_cast<int>(readInteger());
+    if (int_val > std::numeric_limits<int8_t>::max())
+        throw std::overflow_error("Invalid int8_t value");
+    val = static_cast<int8_t>(int_val);
+}
+
+void
+InputArchive::read(unsigned int &val)
+{
+    val = static_cast<unsigned int>(readInteger());
+}
+
+void
+InputArchive::read(uint8_t &val)
+{
+    unsigned int uint_val = static_cast<unsigned int>(readInteger());
+    if (uint_val > std::numeric_limits<uint8_t>::max())
+        throw std::overflow_error("Invalid uint8_t value");
+    val = static_cast<uint8_t>(uint_val);
+}
+
+void
+InputArchive::read(bool &val)
+{
+    const size_t pos = position();
+    if (isLiteral(myText, pos, "true"))
+        val = true;
+    else if (isLiteral(myText, pos, "false"))
+        val = false;
+    else
+        throw std::runtime_error("Expected a boolean");
+}
+
+void
+InputArchive::read(std::string &str)
+{
+    str = parseString(position());
+}
+
 void
 InputArchive::read(Util::Date &date)
 {
@@ -65,10 +709,160 @@ InputArchive::read(Util::Date &date)
     date = Util::Date(greg_date.year(), greg_date.month(), greg_date.day());
 }
 
-JSONValue
-OutputArchive::convert(const Util::Date &date)
+OutputArchive::OutputArchive(std::ostream &os, FileVersion version,
+                             bool pretty)
+    : myStream(os), myVersion(version), myPretty(pretty)
+{
+}
+
+void
+OutputArchive::beginObject()
+{
+    writeRaw("{");
+    myHasEntries.push_back(false);
+}
+
+void
+OutputArchive::endObject()
+{
+    endContainer("}");
+}
+
+void
+OutputArchive::beginArray()
+{
+    writeRaw("[");
+    myHasEntries.push_back(false);
+}
+
+void
+OutputArchive::endArray()
+{
+    endContainer("]");
+}
+
+void
+OutputArchive::endContainer(std::string_view bracket)
+{
+    const bool has_entries = myHasEntries.back();
+    myHasEntries.pop_back();
+
+    // Empty objects and arrays are written on a single line.
+    if (has_entries)
+        writeNewline();
+
+    writeRaw(bracket);
+}
+
+void
+OutputArchive::beginEntry()
+{
+    if (myHasEntries.back())
+        writeRaw(",");
+    myHasEntries.back() = true;
+
+    writeNewline();
+}
+
+void
+OutputArchive::writeNewline()
+{
+    if (!myPretty)
+        return;
+
+    writeRaw("\n");
+
+    // Indent by four spaces per level.
+    static constexpr std::string_view spaces = "                ";
+    for (size_t n = 4 * myHasEntries.size(); n > 0;)
+    {
+        const size_t count = std::min(n, spaces.size());
+        writeRaw(spaces.substr(0, count));
+        n -= count;
+    }
+}
+
+void
+OutputArchive::writeKey(std::string_view name)
+{
+    beginEntry();
+    writeString(name);
+    writeRaw(myPretty ? ": " : ":");
+}
+
+void
+OutputArchive::writeRaw(std::string_view text)
+{
+    myStream.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+void
+OutputArchive::writeString(std::string_view str)
+{
+    writeRaw("\"");
+
+    // Write out runs of characters that don't need to be escaped in one go.
+    size_t start = 0;
+    for (size_t i = 0; i < str.size(); ++i)
+    {
+        const unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        writeRaw(str.substr(start, i - start));
+        start = i + 1;
+
+        switch (c)
+        {
+            case '"':
+                writeRaw("\\\"");
+                break;
+            case '\\':
+                writeRaw("\\\\");
+                break;
+            case '\b':
+                writeRaw("\\b");
+                break;
+            case '\f':
+                writeRaw("\\f");
+                break;
+            case '\n':
+                writeRaw("\\n");
+                break;
+            case '\r':
+                writeRaw("\\r");
+                break;
+            case '\t':
+                writeRaw("\\t");
+                break;
+            default:
+            {
+                static constexpr char hex_digits[] = "0123456789abcdef";
+                const char escape[] = { '\\', 'u', '0', '0',
+                                        hex_digits[c >> 4],
+                                        hex_digits[c & 0xF] };
+                writeRaw(std::string_view(escape, sizeof(escape)));
+                break;
+            }
+        }
+    }
+
+    writeRaw(str.substr(start));
+    writeRaw("\"");
+}
+
+void
+OutputArchive::writeInteger(int64_t val)
+{
+    char buffer[24];
+    auto result = std::to_chars(std::begin(buffer), std::end(buffer), val);
+    writeRaw(std::string_view(buffer, result.ptr - buffer));
+}
+
+void
+OutputArchive::write(const Util::Date &date)
 {
-    return convert(boost::gregorian::to_iso_string(
+    writeString(boost::gregorian::to_iso_string(
         boost::gregorian::date(date.year(), date.month(), date.day())));
 }
 }
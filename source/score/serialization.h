@@ -19,29 +19,40 @@
 #define SCORE_SERIALIZATION_H
 
 #include <array>
+#include <cassert>
+#include <cstdint>
 #include "fileversion.h"
 #include <istream>
-#include <iomanip>
 #include <iostream>
 #include <map>
-#include <nlohmann/json.hpp>
+#include <memory>
+#include <ostream>
 #include <optional>
-#include <stack>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <util/date.h>
 #include <util/enumflags.h>
 #include <util/enumtostring_fwd.h>
+#include <util/parallelfor.h>
 #include <vector>
 
 namespace ScoreUtils
 {
 namespace detail
 {
-    using JSONValue = nlohmann::json;
-
+    /// Reads score objects from JSON text without building a document tree.
+    /// The text is scanned once up front to find the extent of each object and
+    /// array, and values are then only parsed as each serialize() function
+    /// requests them. Since the fields are requested by name and aren't
+    /// necessarily stored in the same order, the members of each object are
+    /// indexed the first time that one of them is requested.
     class InputArchive
     {
     public:
+        /// Allows serialize() functions to distinguish loading from saving.
+        static constexpr bool IsLoading = true;
+
         InputArchive(std::istream &is);
 
         /// The version of the file being read.
@@ -51,32 +62,129 @@ namespace detail
         template <typename T>
         void operator()(const std::string_view &name, T &obj)
         {
-            const JSONValue *parent = myValueStack.top();
-            auto it = parent->find(name);
+            const Value *member = findMember(name);
 
             // Field does not exist. It might have been removed in a newer file
             // version.
-            if (it == parent->end())
+            if (!member)
                 return;
 
-            myValueStack.push(&*it);
+            pushValue(*member);
             read(obj);
-            myValueStack.pop();
+            popValue();
         }
 
     private:
-        /// The current JSON value.
-        const JSONValue &value() const
+        static constexpr size_t NO_CONTAINER = std::string::npos;
+
+        /// The location of an object or array in the text.
+        struct Container
         {
-            return *myValueStack.top();
+            /// Offset just after the closing bracket.
+            size_t myEnd;
+            /// Index of the next container after this one and any containers
+            /// nested inside it.
+            size_t myNext;
+        };
+
+        /// The text and the location of each container, which is shared with
+        /// any worker archives.
+        struct Document
+        {
+            std::string myText;
+            std::vector<Container> myContainers;
+        };
+
+        struct Value
+        {
+            /// Offset of the value in the text.
+            size_t myPosition;
+            /// Index of the container, if the value is an object or array.
+            size_t myContainer;
+        };
+
+        struct Member
+        {
+            /// The key, without the quotes or any escape sequences decoded.
+            std::string_view myRawKey;
+            Value myValue;
+        };
+
+        /// A JSON value that is currently being read.
+        struct Frame
+        {
+            Value myValue;
+            /// For objects, the members after the object has been indexed.
+            bool myIndexed = false;
+            std::vector<Member> myMembers;
+        };
+
+        /// Creates an archive for reading the given value on a worker thread.
+        InputArchive(const InputArchive &parent, Value value);
+
+        /// Checks that the root value at the given offset is valid JSON, and
+        /// finds the extent of each object and array in it. The lazy reads
+        /// afterwards can then skip over values without checking them again.
+        void indexContainers(size_t start);
+
+        /// Returns the member's value in the current object, or null.
+        const Value *findMember(std::string_view name);
+        /// Records the location of each member in the current object.
+        void indexObject(Frame &frame);
+
+        /// Makes the given value the current value.
+        void pushValue(Value value);
+        /// Returns to the previous value.
+        void popValue();
+
+        /// Returns the offset of the current value in the text.
+        size_t position() const
+        {
+            return myFrames[myDepth - 1].myValue.myPosition;
         }
 
-        inline void read(int &val);
-        inline void read(int8_t &val);
-        inline void read(unsigned int &val);
-        inline void read(uint8_t &val);
-        inline void read(bool &val);
-        inline void read(std::string &str);
+        /// Returns the offset just after the given value.
+        size_t getEnd(const Value &value) const;
+        /// Returns the value at the given offset, where the given container
+        /// index is the next container at or after that offset.
+        Value getValue(size_t pos, size_t &next_container) const;
+
+        /// Returns the offset of the first non-whitespace character at or
+        /// after the given offset.
+        size_t skipWhitespace(size_t pos) const;
+        /// Returns the offset just after the string, number, or literal at the
+        /// given offset.
+        size_t skipScalar(size_t pos) const;
+        /// Returns the offset just after the string starting at the given
+        /// offset.
+        size_t skipString(size_t pos) const;
+        /// Decodes the string starting at the given offset.
+        std::string parseString(size_t pos) const;
+        /// Returns the first character of the value at the given offset.
+        char peek(size_t pos) const;
+
+        /// Returns true if the current value is null.
+        bool isNull() const;
+        /// Reads the current value as an integer. Floating point values are
+        /// truncated.
+        int64_t readInteger();
+
+        /// Calls f() with each element of the current array as the current
+        /// value.
+        template <typename F>
+        void forEachElement(F &&f);
+        /// Returns each element of the current array.
+        std::vector<Value> getElements();
+        /// Returns true if the elements of the current array should be read
+        /// on separate threads.
+        bool shouldReadInParallel() const;
+
+        void read(int &val);
+        void read(int8_t &val);
+        void read(unsigned int &val);
+        void read(uint8_t &val);
+        void read(bool &val);
+        void read(std::string &str);
 
         template <typename T>
         void read(std::vector<T> &vec);
@@ -105,10 +213,11 @@ namespace detail
                 // Convert from string to enum.
                 // In older files, enums were stored as ints.
                 if (myVersion < FileVersion::JSON_CLEANUP)
-                    val = static_cast<T>(value().get<int>());
+                    val = static_cast<T>(readInteger());
                 else
                 {
-                    std::string text = value().get<std::string>();
+                    std::string text;
+                    read(text);
                     if (auto result = Util::toEnum<T>(text))
                         val = *result;
                     else
@@ -122,144 +231,205 @@ namespace detail
                 assert(false);
         }
 
-        JSONValue myDocument;
+        std::shared_ptr<Document> myDocument;
+        std::string_view myText;
         FileVersion myVersion;
-
-        std::stack<const JSONValue *> myValueStack;
+        /// Whether this archive is reading part of the document on a worker
+        /// thread.
+        bool myIsWorker = false;
+
+        /// The values currently being read. Frames are reused rather than
+        /// popped to avoid reallocating their member lists.
+        std::vector<Frame> myFrames;
+        size_t myDepth = 0;
     };
 
+    /// Writes score objects as JSON text directly to a stream, as each
+    /// serialize() function visits its fields.
     class OutputArchive
     {
     public:
-        OutputArchive(FileVersion version) : myVersion(version)
-        {
-        }
+        static constexpr bool IsLoading = false;
+
+        OutputArchive(std::ostream &os, FileVersion version, bool pretty);
 
+        /// Generic function to write a value with the given name.
         template <typename T>
-        void operator()(const std::string &name, const T &obj)
+        void operator()(const std::string_view &name, const T &obj)
         {
-            myValue[name] = convert(obj);
+            writeKey(name);
+            write(obj);
         }
 
-        const JSONValue &value() const
-        {
-            return myValue;
-        }
+        /// Starts or finishes the top-level object.
+        void beginObject();
+        void endObject();
 
     private:
+        void beginArray();
+        void endArray();
+        void endContainer(std::string_view bracket);
+
+        /// Starts a new member or array element, writing any separator
+        /// needed.
+        void beginEntry();
+        /// When pretty printing, starts a new line at the current indentation
+        /// level.
+        void writeNewline();
+        void writeKey(std::string_view name);
+
+        void writeRaw(std::string_view text);
+        void writeString(std::string_view str);
+        void writeInteger(int64_t val);
+
         template <typename T>
-        JSONValue convert(const std::vector<T> &vec);
+        void write(const std::vector<T> &vec);
 
         template <typename K, typename V, typename C>
-        JSONValue convert(const std::map<K, V, C> &map);
+        void write(const std::map<K, V, C> &map);
 
         template <typename T, size_t N>
-        JSONValue convert(const std::array<T, N> &arr);
+        void write(const std::array<T, N> &arr);
 
         template <typename EnumT>
-        JSONValue convert(const Util::EnumFlags<EnumT> &flags);
+        void write(const Util::EnumFlags<EnumT> &flags);
 
         template <typename T>
-        JSONValue convert(const std::optional<T> &val);
+        void write(const std::optional<T> &val);
 
-        JSONValue convert(const Util::Date &date);
+        void write(const Util::Date &date);
 
         template <typename T>
-        JSONValue convert(const T &obj)
+        void write(const T &obj)
         {
             // Save ints / bools / etc or strings as-is.
             // Save enums as strings. The exception is the FileVersion enum
             // which is left as an integer.
-            if constexpr (std::is_arithmetic_v<T> || std::is_same_v<T, FileVersion> ||
-                          std::is_same_v<T, std::string>)
-            {
-                return obj;
-            }
+            if constexpr (std::is_same_v<T, bool>)
+                writeRaw(obj ? "true" : "false");
+            else if constexpr (std::is_integral_v<T>)
+                writeInteger(obj);
+            else if constexpr (std::is_same_v<T, FileVersion>)
+                writeInteger(static_cast<int>(obj));
+            else if constexpr (std::is_same_v<T, std::string>)
+                writeString(obj);
             else if constexpr (std::is_enum_v<T>)
-            {
-                return Util::enumToString(obj);
-            }
+                writeString(Util::enumToString(obj));
             else // score objects.
             {
-                OutputArchive ar(myVersion);
-                const_cast<T &>(obj).serialize(ar, myVersion);
-                return std::move(ar.myValue);
+                beginObject();
+                const_cast<T &>(obj).serialize(*this, myVersion);
+                endObject();
             }
         }
 
+        std::ostream &myStream;
         const FileVersion myVersion;
-        JSONValue myValue;
-    };
+        const bool myPretty;
 
-    void InputArchive::read(int &val)
-    {
-        val = value().get<int>();
-    }
+        /// For each object or array currently being written, whether any
+        /// entries have been written to it yet.
+        std::vector<bool> myHasEntries;
+    };
 
-    void InputArchive::read(int8_t &val)
+    template <typename F>
+    void InputArchive::forEachElement(F &&f)
     {
-        int int_val = value().get<int>();
-        if (int_val > std::numeric_limits<int8_t>::max())
-            throw std::overflow_error("Invalid int8_t value");
-        val = static_cast<int8_t>(int_val);
-    }
+        // Empty arrays are written as null.
+        if (isNull())
+            return;
 
-    void InputArchive::read(unsigned int &val)
-    {
-        val = value().get<unsigned int>();
-    }
+        const Value array = myFrames[myDepth - 1].myValue;
+        if (peek(array.myPosition) != '[')
+            throw std::runtime_error("Expected an array");
 
-    void InputArchive::read(uint8_t &val)
-    {
-        unsigned int uint_val = value().get<unsigned int>();
-        if (uint_val > std::numeric_limits<uint8_t>::max())
-            throw std::overflow_error("Invalid uint8_t value");
-        val = static_cast<uint8_t>(uint_val);
-    }
+        size_t pos = skipWhitespace(array.myPosition + 1);
+        if (peek(pos) == ']')
+            return;
 
-    void InputArchive::read(bool &val)
-    {
-        val = value().get<bool>();
-    }
+        size_t next_container = array.myContainer + 1;
+        while (true)
+        {
+            const Value element = getValue(pos, next_container);
+            pushValue(element);
+            f();
+            popValue();
+
+            pos = skipWhitespace(getEnd(element));
+            const char c = peek(pos);
+            if (c == ']')
+                return;
+            else if (c != ',')
+                throw std::runtime_error("Expected ',' or ']'");
 
-    void InputArchive::read(std::string &str)
-    {
-        str = value().get<std::string>();
+            pos = skipWhitespace(pos + 1);
+        }
     }
 
     template <typename T>
     void InputArchive::read(std::vector<T> &vec)
     {
-        const JSONValue &json_array = value();
-        vec.resize(json_array.size());
+        // Objects in large arrays are independent of each other, so they can
+        // be read in parallel.
+        if constexpr (std::is_class_v<T> && !std::is_same_v<T, std::string>)
+        {
+            if (shouldReadInParallel())
+            {
+                const std::vector<Value> elements = getElements();
+                vec.resize(elements.size());
+
+                Util::parallelFor(static_cast<int>(elements.size()),
+                                  [&](int i) {
+                                      InputArchive worker(*this, elements[i]);
+                                      worker.read(vec[i]);
+                                  });
+                return;
+            }
+        }
 
+        // Read into any existing elements, and then remove any extras.
         size_t i = 0;
-        for (const JSONValue &entry : json_array)
-        {
-            myValueStack.push(&entry);
+        forEachElement([&]() {
+            if (i == vec.size())
+                vec.emplace_back();
+
             read(vec[i++]);
-            myValueStack.pop();
-        }
+        });
+
+        vec.erase(vec.begin() + i, vec.end());
     }
 
     template <typename K, typename V, typename C>
     void InputArchive::read(std::map<K, V, C> &map)
     {
-        const JSONValue &json_obj = value();
+        // Empty maps are written as null.
+        if (isNull())
+            return;
+
+        if (peek(position()) != '{')
+            throw std::runtime_error("Expected an object");
 
-        for (auto &&member : json_obj.items())
+        const size_t depth = myDepth - 1;
+        if (!myFrames[depth].myIndexed)
+            indexObject(myFrames[depth]);
+
+        // Look up the frame on each iteration, since reading a value can
+        // reallocate the frame list.
+        for (size_t i = 0; i < myFrames[depth].myMembers.size(); ++i)
         {
+            const Member member = myFrames[depth].myMembers[i];
+
             static_assert(std::is_same<K, int>::value,
                           "Only integer keys are currently supported");
-            const K key = std::stoi(member.key());
+            const K key = std::stoi(std::string(member.myRawKey));
 
-            myValueStack.push(&member.value());
+            pushValue(member.myValue);
 
             V val;
             read(val);
             map[key] = val;
 
-            myValueStack.pop();
+            popValue();
         }
     }
 
@@ -284,20 +454,21 @@ namespace detail
         }
         else
         {
-            const JSONValue &json_array = value();
-            for (const JSONValue &entry : json_array)
-            {
-                auto flag = Util::toEnum<EnumT>(entry.get<std::string>());
+            forEachElement([&]() {
+                std::string text;
+                read(text);
+
+                auto flag = Util::toEnum<EnumT>(text);
                 if (flag) // Ignore any unknown flags from future file versions.
                     flags.setFlag(*flag, true);
-            }
+            });
         }
     }
 
     template <typename T>
     void InputArchive::read(std::optional<T> &val)
     {
-        if (value() == nullptr)
+        if (isNull())
             val.reset();
         else
         {
@@ -308,59 +479,74 @@ namespace detail
     }
 
     template <typename T>
-    JSONValue OutputArchive::convert(const std::vector<T> &vec)
+    void OutputArchive::write(const std::vector<T> &vec)
     {
-        JSONValue arr;
+        beginArray();
 
         for (const T &obj : vec)
-            arr.push_back(convert(obj));
+        {
+            beginEntry();
+            write(obj);
+        }
 
-        return arr;
+        endArray();
     }
 
     template <typename K, typename V, typename C>
-    JSONValue OutputArchive::convert(const std::map<K, V, C> &map)
+    void OutputArchive::write(const std::map<K, V, C> &map)
     {
-        JSONValue obj;
+        beginObject();
 
         for (auto &&[key, value] : map)
-            obj[std::to_string(key)] = convert(value);
+        {
+            writeKey(std::to_string(key));
+            write(value);
+        }
 
-        return obj;
+        endObject();
     }
 
     template <typename T, size_t N>
-    JSONValue OutputArchive::convert(const std::array<T, N> &arr)
+    void OutputArchive::write(const std::array<T, N> &arr)
     {
-        JSONValue obj;
+        beginObject();
 
         for (size_t i = 0; i < N; ++i)
-            obj[std::to_string(i)] = convert(arr[i]);
+        {
+            writeKey(std::to_string(i));
+            write(arr[i]);
+        }
 
-        return obj;
+        endObject();
     }
 
     template <typename EnumT>
-    JSONValue OutputArchive::convert(const Util::EnumFlags<EnumT> &flags)
+    void OutputArchive::write(const Util::EnumFlags<EnumT> &flags)
     {
-        JSONValue arr = JSONValue::array();
-
-        // Convert to an array of strings, with the enum values for the active
+        // Write an array of strings, with the enum values for the active
         // flags.
+        beginArray();
+
         for (size_t i = 0; i < Util::EnumFlags<EnumT>::NumFlags; ++i)
         {
             auto flag = static_cast<EnumT>(i);
             if (flags.getFlag(flag))
-                arr.push_back(Util::enumToString(flag));
+            {
+                beginEntry();
+                writeString(Util::enumToString(flag));
+            }
         }
 
-        return arr;
+        endArray();
     }
 
     template <typename T>
-    JSONValue OutputArchive::convert(const std::optional<T> &val)
+    void OutputArchive::write(const std::optional<T> &val)
     {
-        return val ? convert(*val) : JSONValue(nullptr);
+        if (val)
+            write(*val);
+        else
+            writeRaw("null");
     }
 } // namespace detail
 
@@ -378,15 +564,11 @@ save(std::ostream &output, const std::string &name, const T &obj,
      bool pretty = true)
 {
     FileVersion version = FileVersion::LATEST_VERSION;
-    detail::OutputArchive ar(version);
+    detail::OutputArchive ar(output, version, pretty);
+    ar.beginObject();
     ar("version", version);
     ar(name, obj);
-
-    // Pretty print.
-    if (pretty)
-        output << std::setw(4);
-
-    output << ar.value();
+    ar.endObject();
 }
 } // namespace ScoreUtils
 
@@ -18,66 +18,93 @@
 #include "system.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <memory>
 #include <ranges>
 #include "utils.h"
 
+static uint64_t
+nextGeneration()
+{
+    static std::atomic<uint64_t> theNextGeneration = 0;
+    return theNextGeneration++;
+}
+
 System::System()
+    : myData(std::make_shared<Data>()), myGeneration(nextGeneration())
 {
     // Add the start and end bars.
-    myBarlines.push_back(Barline());
+    myData->myBarlines.push_back(Barline());
     Barline endBar;
     endBar.setPosition(30);
-    myBarlines.push_back(endBar);
+    myData->myBarlines.push_back(endBar);
 }
 
 bool System::operator==(const System &other) const
 {
-    return myStaves == other.myStaves && myBarlines == other.myBarlines &&
-           myTempoMarkers == other.myTempoMarkers &&
-           myAlternateEndings == other.myAlternateEndings &&
-           myDirections == other.myDirections &&
-           myPlayerChanges == other.myPlayerChanges &&
-           myChords == other.myChords &&
-           myTextItems == other.myTextItems;
+    return myData == other.myData || *myData == *other.myData;
+}
+
+System::Data &System::modify()
+{
+    // Make a private copy if the data is shared with another system.
+    if (myData.use_count() > 1)
+    {
+        myData = std::make_shared<Data>(*myData);
+        myGeneration = nextGeneration();
+    }
+    else
+    {
+        // The last other owner may have just released the data on another
+        // thread (e.g. the autosave thread), so synchronize with its release
+        // of the reference before writing to the data.
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    return *myData;
 }
 
 void System::insertStaff(const Staff &staff)
 {
-    myStaves.push_back(staff);
+    modify().myStaves.push_back(staff);
 }
 
 void System::insertStaff(Staff &&staff)
 {
-    myStaves.push_back(std::move(staff));
+    modify().myStaves.push_back(std::move(staff));
 }
 
 void System::insertStaff(const Staff &staff, int index)
 {
-    myStaves.insert(myStaves.begin() + index, staff);
+    std::vector<Staff> &staves = modify().myStaves;
+    staves.insert(staves.begin() + index, staff);
 }
 
 void System::removeStaff(int index)
 {
-    myStaves.erase(myStaves.begin() + index);
+    std::vector<Staff> &staves = modify().myStaves;
+    staves.erase(staves.begin() + index);
 }
 
 void System::insertBarline(const Barline &barline)
 {
+    std::vector<Barline> &barlines = modify().myBarlines;
+
     // Ensure that the end bar remains the end bar.
-    myBarlines.back().setPosition(
-        std::max(myBarlines.back().getPosition(), barline.getPosition() + 1));
-    ScoreUtils::insertObject(myBarlines, barline);
+    barlines.back().setPosition(
+        std::max(barlines.back().getPosition(), barline.getPosition() + 1));
+    ScoreUtils::insertObject(barlines, barline);
 }
 
 void System::removeBarline(const Barline &barline)
 {
-    ScoreUtils::removeObject(myBarlines, barline);
+    ScoreUtils::removeObject(modify().myBarlines, barline);
 }
 
 const Barline *System::getPreviousBarline(int position) const
 {
-    for (const Barline &barline : std::views::reverse(myBarlines))
+    for (const Barline &barline : std::views::reverse(myData->myBarlines))
     {
         if (barline.getPosition() < position)
             return &barline;
@@ -88,7 +115,7 @@ const Barline *System::getPreviousBarline(int position) const
 
 const Barline *System::getNextBarline(int position) const
 {
-    for (const Barline &barline : myBarlines)
+    for (const Barline &barline : myData->myBarlines)
     {
         if (barline.getPosition() > position)
             return &barline;
@@ -99,7 +126,7 @@ const Barline *System::getNextBarline(int position) const
 
 Barline *System::getNextBarline(int position)
 {
-    for (Barline &barline : myBarlines)
+    for (Barline &barline : modify().myBarlines)
     {
         if (barline.getPosition() > position)
             return &barline;
@@ -110,62 +137,62 @@ Barline *System::getNextBarline(int position)
 
 void System::insertTempoMarker(const TempoMarker &marker)
 {
-    ScoreUtils::insertObject(myTempoMarkers, marker);
+    ScoreUtils::insertObject(modify().myTempoMarkers, marker);
 }
 
 void System::removeTempoMarker(const TempoMarker &marker)
 {
-    ScoreUtils::removeObject(myTempoMarkers, marker);
+    ScoreUtils::removeObject(modify().myTempoMarkers, marker);
 }
 
 void System::insertAlternateEnding(const AlternateEnding &ending)
 {
-    ScoreUtils::insertObject(myAlternateEndings, ending);
+    ScoreUtils::insertObject(modify().myAlternateEndings, ending);
 }
 
 void System::removeAlternateEnding(const AlternateEnding &ending)
 {
-    ScoreUtils::removeObject(myAlternateEndings, ending);
+    ScoreUtils::removeObject(modify().myAlternateEndings, ending);
 }
 
 void System::insertDirection(const Direction &direction)
 {
-    ScoreUtils::insertObject(myDirections, direction);
+    ScoreUtils::insertObject(modify().myDirections, direction);
 }
 
 void System::removeDirection(const Direction &direction)
 {
-    ScoreUtils::removeObject(myDirections, direction);
+    ScoreUtils::removeObject(modify().myDirections, direction);
 }
 
 void System::insertPlayerChange(const PlayerChange &change)
 {
-    ScoreUtils::insertObject(myPlayerChanges, change);
+    ScoreUtils::insertObject(modify().myPlayerChanges, change);
 }
 
 void System::removePlayerChange(const PlayerChange &change)
 {
-    ScoreUtils::removeObject(myPlayerChanges, change);
+    ScoreUtils::removeObject(modify().myPlayerChanges, change);
 }
 
 void System::insertChord(const ChordText &chord)
 {
-    ScoreUtils::insertObject(myChords, chord);
+    ScoreUtils::insertObject(modify().myChords, chord);
 }
 
 void System::removeChord(const ChordText &chord)
 {
-    ScoreUtils::removeObject(myChords, chord);
+    ScoreUtils::removeObject(modify().myChords, chord);
 }
 
 void System::insertTextItem(const TextItem &text)
 {
-    ScoreUtils::insertObject(myTextItems, text);
+    ScoreUtils::insertObject(modify().myTextItems, text);
 }
 
 void System::removeTextItem(const TextItem &text)
 {
-    ScoreUtils::removeObject(myTextItems, text);
+    ScoreUtils::removeObject(modify().myTextItems, text);
 }
 
 template <typename T>
@@ -27,23 +27,40 @@
 #include "staff.h"
 #include "tempomarker.h"
 #include "textitem.h"
+#include <cstdint>
+#include <memory>
 #include <span>
 #include <vector>
 
+/// A system of staves.
+///
+/// Copies of a system share their data until one of them is modified, so
+/// copying a score (e.g. for an undo snapshot or a backup) is cheap. Calling any
+/// non-const accessor gives the system a private copy of its data if it is
+/// shared, which invalidates all references into the system (including const
+/// references) held by other code. Anything that caches references into a
+/// system must check that getGeneration() is unchanged before using them.
 class System
 {
 public:
     System();
+    // Moving is not declared, so a moved-from system still has valid data.
+    System(const System &other) = default;
+    System &operator=(const System &other) = default;
 
     bool operator==(const System &other) const;
 
+    /// Returns an identifier for the system's data, which changes whenever the
+    /// system stops sharing its data with another system.
+    uint64_t getGeneration() const { return myGeneration; }
+
     template <class Archive>
     void serialize(Archive &ar, const FileVersion version);
 
     /// Returns the set of staves in the system.
-    std::span<Staff> getStaves() { return myStaves; }
+    std::span<Staff> getStaves() { return modify().myStaves; }
     /// Returns the set of staves in the system.
-    std::span<const Staff> getStaves() const { return myStaves; }
+    std::span<const Staff> getStaves() const { return myData->myStaves; }
 
     /// Adds a new staff to the system.
     void insertStaff(const Staff &staff);
@@ -53,9 +70,9 @@ public:
     void removeStaff(int index);
 
     /// Returns the set of barlines in the system.
-    std::span<Barline> getBarlines() { return myBarlines; }
+    std::span<Barline> getBarlines() { return modify().myBarlines; }
     /// Returns the set of barlines in the system.
-    std::span<const Barline> getBarlines() const { return myBarlines; }
+    std::span<const Barline> getBarlines() const { return myData->myBarlines; }
 
     /// Adds a new barline to the system.
     void insertBarline(const Barline &barline);
@@ -69,9 +86,9 @@ public:
     Barline *getNextBarline(int position);
 
     /// Returns the set of tempo markers in the system.
-    std::span<TempoMarker> getTempoMarkers() { return myTempoMarkers; }
+    std::span<TempoMarker> getTempoMarkers() { return modify().myTempoMarkers; }
     /// Returns the set of tempo markers in the system.
-    std::span<const TempoMarker> getTempoMarkers() const { return myTempoMarkers; }
+    std::span<const TempoMarker> getTempoMarkers() const { return myData->myTempoMarkers; }
 
     /// Adds a new tempo marker to the system.
     void insertTempoMarker(const TempoMarker &marker);
@@ -79,9 +96,9 @@ public:
     void removeTempoMarker(const TempoMarker &marker);
 
     /// Returns the set of alternate endings in the system.
-    std::span<AlternateEnding> getAlternateEndings() { return myAlternateEndings; }
+    std::span<AlternateEnding> getAlternateEndings() { return modify().myAlternateEndings; }
     /// Returns the set of alternate endings in system.
-    std::span<const AlternateEnding> getAlternateEndings() const { return myAlternateEndings; }
+    std::span<const AlternateEnding> getAlternateEndings() const { return myData->myAlternateEndings; }
 
     /// Adds a new alternate ending to the system.
     void insertAlternateEnding(const AlternateEnding &ending);
@@ -89,9 +106,9 @@ public:
     void removeAlternateEnding(const AlternateEnding &ending);
 
     /// Returns the set of musical directions in the system.
-    std::span<Direction> getDirections() { return myDirections; }
+    std::span<Direction> getDirections() { return modify().myDirections; }
     /// Returns the set of musical directions in system.
-    std::span<const Direction> getDirections() const { return myDirections; }
+    std::span<const Direction> getDirections() const { return myData->myDirections; }
 
     /// Adds a new musical direction to the system.
     void insertDirection(const Direction &direction);
@@ -99,9 +116,9 @@ public:
     void removeDirection(const Direction &direction);
 
     /// Returns the set of player changes in the system.
-    std::span<PlayerChange> getPlayerChanges() { return myPlayerChanges; }
+    std::span<PlayerChange> getPlayerChanges() { return modify().myPlayerChanges; }
     /// Returns the set of player changes in system.
-    std::span<const PlayerChange> getPlayerChanges() const { return myPlayerChanges; }
+    std::span<const PlayerChange> getPlayerChanges() const { return myData->myPlayerChanges; }
 
     /// Adds a new player change to the system.
     void insertPlayerChange(const PlayerChange &change);
@@ -109,9 +126,9 @@ public:
     void removePlayerChange(const PlayerChange &change);
 
     /// Returns the set of chord symbols in the system.
-    std::span<ChordText> getChords() { return myChords; }
+    std::span<ChordText> getChords() { return modify().myChords; }
     /// Returns the set of chord symbols in system.
-    std::span<const ChordText> getChords() const { return myChords; }
+    std::span<const ChordText> getChords() const { return myData->myChords; }
 
     /// Adds a new chord symbol to the system.
     void insertChord(const ChordText &chord);
@@ -119,9 +136,9 @@ public:
     void removeChord(const ChordText &chord);
 
     /// Returns the set of text items in the system.
-    std::span<TextItem> getTextItems() { return myTextItems; }
+    std::span<TextItem> getTextItems() { return modify().myTextItems; }
     /// Returns the set of text items in system.
-    std::span<const TextItem> getTextItems() const { return myTextItems; }
+    std::span<const TextItem> getTextItems() const { return myData->myTextItems; }
 
     /// Adds a new text item to the system.
     void insertTextItem(const TextItem &text);
@@ -129,20 +146,46 @@ public:
     void removeTextItem(const TextItem &text);
 
 private:
-    std::vector<Staff> myStaves;
-    /// List of the barlines in the system. This will always contain at least
-    /// two barlines - the start and end bars.
-    std::vector<Barline> myBarlines;
-    std::vector<TempoMarker> myTempoMarkers;
-    std::vector<AlternateEnding> myAlternateEndings;
-    std::vector<Direction> myDirections;
-    std::vector<PlayerChange> myPlayerChanges;
-    std::vector<ChordText> myChords;
-    std::vector<TextItem> myTextItems;
+    struct Data
+    {
+        bool operator==(const Data &other) const = default;
+
+        template <class Archive>
+        void serialize(Archive &ar, const FileVersion version);
+
+        std::vector<Staff> myStaves;
+        /// List of the barlines in the system. This will always contain at
+        /// least two barlines - the start and end bars.
+        std::vector<Barline> myBarlines;
+        std::vector<TempoMarker> myTempoMarkers;
+        std::vector<AlternateEnding> myAlternateEndings;
+        std::vector<Direction> myDirections;
+        std::vector<PlayerChange> myPlayerChanges;
+        std::vector<ChordText> myChords;
+        std::vector<TextItem> myTextItems;
+    };
+
+    /// Returns the system's data for modification, first making a private
+    /// copy if it is shared with another system.
+    Data &modify();
+
+    std::shared_ptr<Data> myData;
+    uint64_t myGeneration;
 };
 
 template <class Archive>
 void System::serialize(Archive &ar, const FileVersion version)
+{
+    // Saving only reads the data, so it doesn't need to be unshared (e.g. when
+    // a backup is saved while the original score is being edited).
+    if constexpr (Archive::IsLoading)
+        modify().serialize(ar, version);
+    else
+        myData->serialize(ar, version);
+}
+
+template <class Archive>
+void System::Data::serialize(Archive &ar, const FileVersion version)
 {
     ar("staves", myStaves);
     ar("barlines", myBarlines);
@@ -151,6 +194,7 @@ void System::serialize(Archive &ar, const FileVersion version)
     ar("directions", myDirections);
     ar("player_changes", myPlayerChanges);
     ar("chords", myChords);
+
     if (version >= FileVersion::TEXT_ITEMS)
         ar("text_items", myTextItems);
 }
@@ -27,6 +27,7 @@
 #include <score/utils.h>
 #include <score/utils/repeatindexer.h>
 #include <score/voiceutils.h>
+#include <util/parallelfor.h>
 
 static const int thePositionLimit = 30;
 static const ViewOptions theDefaultViewOptions;
@@ -976,8 +977,12 @@ void ScoreMerger::merge(Score &dest_score, Score &guitar_score,
 {
     ExpandedBarList guitar_bars;
     ExpandedBarList bass_bars;
-    expandScore(guitar_score, guitar_bars);
-    expandScore(bass_score, bass_bars);
+    Util::parallelFor(2, [&](int i) {
+        if (i == 0)
+            expandScore(guitar_score, guitar_bars);
+        else
+            expandScore(bass_score, bass_bars);
+    });
 
     mergeMultiBarRests(guitar_bars, bass_bars);
     mergeRepeats(guitar_bars, bass_bars);
@@ -0,0 +1,140 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UTIL_PARALLELFOR_H
+#define UTIL_PARALLELFOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace Util
+{
+namespace detail
+{
+inline thread_local bool theIsParallelWorker = false;
+}
+
+/// Marks the current thread as a worker of a parallel task while in scope.
+/// Any parallelFor() calls made by the worker run serially, so that nested
+/// parallel tasks (e.g. rendering a score while processing many files in
+/// parallel) don't start a pool of threads from every worker.
+class ParallelWorkerScope
+{
+public:
+    ParallelWorkerScope() : myPrevValue(detail::theIsParallelWorker)
+    {
+        detail::theIsParallelWorker = true;
+    }
+
+    ParallelWorkerScope(const ParallelWorkerScope &) = delete;
+    ParallelWorkerScope &operator=(const ParallelWorkerScope &) = delete;
+
+    ~ParallelWorkerScope()
+    {
+        detail::theIsParallelWorker = myPrevValue;
+    }
+
+private:
+    const bool myPrevValue;
+};
+
+/// Returns the number of worker threads to use for a task with the given
+/// number of work items, which is at least one.
+inline int getWorkerCount(int num_items, int max_threads = 0)
+{
+    int num_threads = max_threads > 0
+                          ? max_threads
+                          : static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(num_threads, num_items));
+}
+
+/// Calls f(i) for each i in [0, count) using a pool of worker threads.
+/// Rather than splitting the range into fixed chunks, each worker claims the
+/// next unprocessed index when it becomes idle, so that a few expensive items
+/// don't leave the other threads waiting.
+/// If max_threads is zero, one thread per hardware core is used. When called
+/// from a worker thread of another parallel task, the items are processed
+/// serially on the current thread. If any call throws, the first exception is
+/// rethrown after all workers have finished.
+template <typename F>
+void parallelFor(int count, F f, int max_threads = 0)
+{
+    const int num_threads = detail::theIsParallelWorker
+                                ? 1
+                                : getWorkerCount(count, max_threads);
+    if (num_threads == 1)
+    {
+        for (int i = 0; i < count; ++i)
+            f(i);
+        return;
+    }
+
+    std::atomic<int> next_index = 0;
+    auto worker = [&]()
+    {
+        ParallelWorkerScope worker_scope;
+        try
+        {
+            for (int i = next_index++; i < count; i = next_index++)
+                f(i);
+        }
+        catch (...)
+        {
+            // Stop the other workers from claiming any more items.
+            next_index = count;
+            throw;
+        }
+    };
+
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(num_threads - 1);
+    for (int i = 0; i < num_threads - 1; ++i)
+        tasks.push_back(std::async(std::launch::async, worker));
+
+    // Do some of the work on the current thread as well.
+    std::exception_ptr error;
+    try
+    {
+        worker();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    for (auto &&task : tasks)
+    {
+        try
+        {
+            task.get();
+        }
+        catch (...)
+        {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+} // namespace Util
+
+#endif
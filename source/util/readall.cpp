@@ -0,0 +1,39 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "readall.h"
+
+#include <istream>
+
+namespace Util
+{
+std::string readAll(std::istream &is)
+{
+    constexpr size_t chunk_size = 64 * 1024;
+    std::string data;
+    size_t size = 0;
+    while (is)
+    {
+        data.resize(size + chunk_size);
+        is.read(data.data() + size, chunk_size);
+        size += static_cast<size_t>(is.gcount());
+    }
+    data.resize(size);
+
+    return data;
+}
+} // namespace Util
@@ -0,0 +1,31 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UTIL_READALL_H
+#define UTIL_READALL_H
+
+#include <iosfwd>
+#include <string>
+
+namespace Util
+{
+/// Reads the remaining contents of the stream in large chunks, rather than
+/// e.g. byte by byte. Check is.bad() afterwards for read errors.
+std::string readAll(std::istream &is);
+} // namespace Util
+
+#endif
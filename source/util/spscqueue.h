@@ -0,0 +1,192 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UTIL_SPSCQUEUE_H
+#define UTIL_SPSCQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Util
+{
+/// A bounded lock-free queue for passing items from a single producer thread
+/// to a single consumer thread.
+/// The non-blocking tryPush() / tryPop() functions are suitable for e.g. a
+/// real-time thread, while push() / pop() wait for space or for an item to be
+/// available. Either thread can close() the queue to stop the other side.
+///
+/// tryPush() and tryPop() only wake up the other thread if it is waiting, so
+/// they don't make any system calls while both threads are busy. A producer
+/// that is waiting in push() is only woken up once the queue has drained to
+/// half of its capacity, so that it refills the queue in batches.
+template <typename T>
+class SpscQueue
+{
+public:
+    /// The capacity is rounded up to a power of two.
+    explicit SpscQueue(size_t capacity)
+        : mySlots(std::bit_ceil(std::max<size_t>(capacity, 1))),
+          myMask(mySlots.size() - 1)
+    {
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /// Adds an item if there is space available, without blocking.
+    bool tryPush(T &&item)
+    {
+        const size_t tail = myTail.load(std::memory_order_relaxed);
+        if (tail - myHead.load(std::memory_order_acquire) == mySlots.size())
+            return false;
+
+        mySlots[tail & myMask] = std::move(item);
+        myTail.store(tail + 1, std::memory_order_seq_cst);
+        notifyIfWaiting(myConsumerWaiting);
+        return true;
+    }
+
+    /// Removes the next item if there is one, without blocking.
+    std::optional<T> tryPop()
+    {
+        const size_t head = myHead.load(std::memory_order_relaxed);
+        if (head == myTail.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        std::optional<T> item = std::move(mySlots[head & myMask]);
+        mySlots[head & myMask].reset();
+        myHead.store(head + 1, std::memory_order_seq_cst);
+
+        // The tail only moves forward, so a stale value can only cause an
+        // extra wakeup rather than a missed one.
+        if (myTail.load(std::memory_order_relaxed) - (head + 1) <=
+            lowWaterMark())
+        {
+            notifyIfWaiting(myProducerWaiting);
+        }
+
+        return item;
+    }
+
+    /// Adds an item, waiting until there is space available. Returns false if
+    /// the queue was closed.
+    bool push(T item)
+    {
+        while (!isClosed())
+        {
+            if (tryPush(std::move(item)))
+                return true;
+
+            waitUntil(myProducerWaiting, [this]() {
+                return isClosed() || size() <= lowWaterMark();
+            });
+        }
+
+        return false;
+    }
+
+    /// Removes the next item, waiting until one is available. Returns
+    /// std::nullopt once the queue is closed and empty.
+    std::optional<T> pop()
+    {
+        while (true)
+        {
+            if (std::optional<T> item = tryPop())
+                return item;
+
+            if (isClosed())
+                return tryPop();
+
+            waitUntil(myConsumerWaiting,
+                      [this]() { return isClosed() || size() != 0; });
+        }
+    }
+
+    /// Prevents any further items from being added, and wakes up any thread
+    /// that is waiting in push() or pop().
+    void close()
+    {
+        myClosed.store(true, std::memory_order_release);
+
+        // Either thread might be waiting.
+        myVersion.fetch_add(1, std::memory_order_release);
+        myVersion.notify_all();
+    }
+
+    bool isClosed() const { return myClosed.load(std::memory_order_acquire); }
+
+private:
+    size_t size() const
+    {
+        return myTail.load(std::memory_order_seq_cst) -
+               myHead.load(std::memory_order_seq_cst);
+    }
+
+    /// A waiting producer is woken up once the queue has this many items or
+    /// fewer.
+    size_t lowWaterMark() const { return mySlots.size() / 2; }
+
+    /// Waits until ready() returns true, or until the other thread notifies
+    /// it (which may be spurious).
+    template <typename Ready>
+    void waitUntil(std::atomic<bool> &waiting, Ready ready)
+    {
+        const uint32_t version = myVersion.load(std::memory_order_acquire);
+
+        // The flag, head and tail are sequentially consistent so that either
+        // the other thread sees the flag, or ready() sees the other thread's
+        // change to the queue.
+        waiting.store(true, std::memory_order_seq_cst);
+        if (!ready())
+            myVersion.wait(version, std::memory_order_acquire);
+
+        waiting.store(false, std::memory_order_relaxed);
+    }
+
+    /// Wakes up the other thread if it is waiting for the queue to change.
+    void notifyIfWaiting(const std::atomic<bool> &waiting)
+    {
+        if (!waiting.load(std::memory_order_seq_cst))
+            return;
+
+        myVersion.fetch_add(1, std::memory_order_release);
+        myVersion.notify_all();
+    }
+
+    std::vector<std::optional<T>> mySlots;
+    const size_t myMask;
+
+    /// Index of the next item to be popped. Only modified by the consumer.
+    alignas(64) std::atomic<size_t> myHead = 0;
+    /// Index of the next item to be pushed. Only modified by the producer.
+    alignas(64) std::atomic<size_t> myTail = 0;
+    /// Incremented to wake up a thread that is waiting in push() or pop().
+    alignas(64) std::atomic<uint32_t> myVersion = 0;
+    /// Whether each thread is waiting, so that the other thread only needs to
+    /// notify it in that case.
+    std::atomic<bool> myProducerWaiting = false;
+    std::atomic<bool> myConsumerWaiting = false;
+    std::atomic<bool> myClosed = false;
+};
+} // namespace Util
+
+#endif
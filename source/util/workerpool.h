@@ -0,0 +1,76 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UTIL_WORKERPOOL_H
+#define UTIL_WORKERPOOL_H
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <util/parallelfor.h>
+#include <util/scopeexit.h>
+#include <util/workqueue.h>
+#include <vector>
+
+namespace Util
+{
+/// Processes the items added by a producer on a pool of worker threads, e.g.
+/// for converting many files.
+///
+/// The producer is called on the current thread as producer(queue), and
+/// pushes items to the queue. Each worker is called as
+/// worker(queue, temp_dir), and pops items until the queue is empty. Since
+/// the workers already run in parallel, any parallelFor() calls that they make
+/// run serially.
+///
+/// Each worker is given its own temporary folder inside temp_root, so that two
+/// workers can write files with the same name. The temp_root folder is removed
+/// once all of the workers have finished.
+/// If the producer throws, the workers still finish the queued items before
+/// the exception is rethrown.
+template <typename T, typename Producer, typename Worker>
+void runWorkerPool(int num_workers, const std::filesystem::path &temp_root,
+                   Producer producer, Worker worker)
+{
+    ScopeExit remove_temp_dir([&]() {
+        std::error_code ec;
+        std::filesystem::remove_all(temp_root, ec);
+    });
+
+    WorkQueue<T> queue(4 * num_workers);
+
+    std::vector<std::thread> workers;
+    ScopeExit join_workers([&]() {
+        queue.close();
+        for (std::thread &thread : workers)
+            thread.join();
+    });
+
+    for (int i = 0; i < num_workers; ++i)
+    {
+        workers.emplace_back([&, i]() {
+            ParallelWorkerScope worker_scope;
+            worker(queue, temp_root / std::to_string(i));
+        });
+    }
+
+    producer(queue);
+}
+} // namespace Util
+
+#endif
@@ -0,0 +1,111 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UTIL_WORKQUEUE_H
+#define UTIL_WORKQUEUE_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace Util
+{
+/// A bounded queue for passing work items from any number of producer threads
+/// to a pool of consumer threads.
+/// Since push() waits for space to be available, a fast producer (e.g. walking
+/// a directory tree) can't get too far ahead of the consumers.
+template <typename T>
+class WorkQueue
+{
+public:
+    explicit WorkQueue(size_t capacity) : myCapacity(std::max<size_t>(capacity, 1))
+    {
+    }
+
+    WorkQueue(const WorkQueue &) = delete;
+    WorkQueue &operator=(const WorkQueue &) = delete;
+
+    /// Adds an item, waiting until there is space available. Returns false if
+    /// the queue was closed.
+    bool push(T item)
+    {
+        {
+            std::unique_lock lock(myMutex);
+            myNotFull.wait(lock, [this]() {
+                return myClosed || myItems.size() < myCapacity;
+            });
+
+            if (myClosed)
+                return false;
+
+            myItems.push_back(std::move(item));
+        }
+
+        myNotEmpty.notify_one();
+        return true;
+    }
+
+    /// Removes the next item, waiting until one is available. Returns
+    /// std::nullopt once the queue is closed and empty.
+    std::optional<T> pop()
+    {
+        std::optional<T> item;
+        {
+            std::unique_lock lock(myMutex);
+            myNotEmpty.wait(lock, [this]() {
+                return myClosed || !myItems.empty();
+            });
+
+            if (myItems.empty())
+                return std::nullopt;
+
+            item = std::move(myItems.front());
+            myItems.pop_front();
+        }
+
+        myNotFull.notify_one();
+        return item;
+    }
+
+    /// Prevents any further items from being added, and wakes up any thread
+    /// that is waiting in push() or pop(). Remaining items can still be
+    /// removed.
+    void close()
+    {
+        {
+            std::lock_guard lock(myMutex);
+            myClosed = true;
+        }
+
+        myNotEmpty.notify_all();
+        myNotFull.notify_all();
+    }
+
+private:
+    const size_t myCapacity;
+    std::mutex myMutex;
+    std::condition_variable myNotEmpty;
+    std::condition_variable myNotFull;
+    std::deque<T> myItems;
+    bool myClosed = false;
+};
+} // namespace Util
+
+#endif
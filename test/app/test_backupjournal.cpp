@@ -0,0 +1,165 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <app/backupjournal.h>
+#include <app/paths.h>
+#include <fstream>
+#include <score/binaryserialization.h>
+#include <score/score.h>
+
+TEST_CASE("App/BackupJournal")
+{
+    Score score;
+    for (int i = 0; i < 3; ++i)
+    {
+        System system;
+        system.insertStaff(Staff(6));
+        score.insertSystem(system);
+    }
+
+    const auto path = Paths::getAppDirPath("data/__generated.pt2j");
+    BackupJournal journal(path);
+    REQUIRE(!journal.hasSnapshot());
+    REQUIRE_THROWS(journal.saveChanges(score, {}));
+
+    journal.saveSnapshot(score);
+    REQUIRE(journal.hasSnapshot());
+
+    // Modify a system and the score's players.
+    score.getSystems()[1].insertTextItem(TextItem(2, "foo"));
+    Player player;
+    player.setDescription("Player 1");
+    score.insertPlayer(player);
+
+    const int systems[] = { 1 };
+    journal.saveChanges(score, systems);
+    REQUIRE(!journal.needsCompaction());
+
+    Score loaded_score;
+    BackupJournal::load(path, loaded_score);
+    REQUIRE(loaded_score == score);
+
+    // A record that was only partially written should be ignored.
+    const Score prev_score(score);
+    score.getSystems()[2].insertTextItem(TextItem(4, "bar"));
+    const int systems2[] = { 2 };
+    journal.saveChanges(score, systems2);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+
+    BackupJournal::load(path, loaded_score);
+    REQUIRE(loaded_score == prev_score);
+
+    // Saving a new snapshot replaces the old contents.
+    journal.saveSnapshot(score);
+    BackupJournal::load(path, loaded_score);
+    REQUIRE(loaded_score == score);
+
+    // If the file was removed (e.g. by another instance), a new snapshot
+    // should be written rather than appending to a missing file.
+    std::filesystem::remove(path);
+    score.getSystems()[0].insertTextItem(TextItem(6, "baz"));
+    const int systems3[] = { 0 };
+    journal.saveChanges(score, systems3);
+    BackupJournal::load(path, loaded_score);
+    REQUIRE(loaded_score == score);
+
+    // A record with a corrupt length that exceeds the file size should be
+    // treated as a partially written record.
+    {
+        std::ofstream output(path, std::ios::out | std::ios::binary |
+                                       std::ios::app);
+        const char header[] = { 'C', '\xff', '\xff', '\xff', '\x7f', 'x' };
+        output.write(header, sizeof(header));
+    }
+    BackupJournal::load(path, loaded_score);
+    REQUIRE(loaded_score == score);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("App/BackupJournal/SameFileName")
+{
+    // Files with the same name in different directories must not share a
+    // journal.
+    const std::filesystem::path path_a = "a/song.pt2";
+    const std::filesystem::path path_b = "b/song.pt2";
+    REQUIRE(BackupJournal::getName(path_a) == BackupJournal::getName(path_a));
+    REQUIRE(BackupJournal::getName(path_a) != BackupJournal::getName(path_b));
+
+    Score score_a;
+    score_a.insertSystem(System());
+    Score score_b;
+    score_b.insertSystem(System());
+    score_b.insertSystem(System());
+
+    auto journal_path = [](const std::filesystem::path &orig_path) {
+        auto name = BackupJournal::getName(orig_path);
+        name += BackupJournal::FILE_EXTENSION;
+        return Paths::getAppDirPath("data") / name;
+    };
+
+    BackupJournal journal_a(journal_path(path_a));
+    BackupJournal journal_b(journal_path(path_b));
+    journal_a.saveSnapshot(score_a);
+    journal_b.saveSnapshot(score_b);
+
+    score_a.getSystems()[0].insertTextItem(TextItem(2, "foo"));
+    score_b.getSystems()[1].insertTextItem(TextItem(4, "bar"));
+    const int systems_a[] = { 0 };
+    const int systems_b[] = { 1 };
+    journal_a.saveChanges(score_a, systems_a);
+    journal_b.saveChanges(score_b, systems_b);
+
+    Score loaded_score;
+    BackupJournal::load(journal_a.getPath(), loaded_score);
+    REQUIRE(loaded_score == score_a);
+    BackupJournal::load(journal_b.getPath(), loaded_score);
+    REQUIRE(loaded_score == score_b);
+
+    std::filesystem::remove(journal_a.getPath());
+    std::filesystem::remove(journal_b.getPath());
+}
+
+TEST_CASE("App/BackupJournal/Recover")
+{
+    Score score;
+    score.insertSystem(System());
+
+    const auto path = Paths::getAppDirPath("data/__generated.pt2j");
+    BackupJournal journal(path);
+    journal.saveSnapshot(score);
+
+    // If the backup file can't be written, the journal must be kept.
+    const auto missing_dir_path =
+        Paths::getAppDirPath("data/__missing_dir/__generated.pt2b");
+    REQUIRE_THROWS(BackupJournal::recover(path, missing_dir_path));
+    REQUIRE(std::filesystem::exists(path));
+
+    const auto backup_path = Paths::getAppDirPath("data/__generated.pt2b");
+    BackupJournal::recover(path, backup_path);
+    REQUIRE(!std::filesystem::exists(path));
+
+    Score loaded_score;
+    std::ifstream input(backup_path, std::ios::in | std::ios::binary);
+    ScoreUtils::loadBinary(input, loaded_score);
+    REQUIRE(loaded_score == score);
+
+    input.close();
+    std::filesystem::remove(backup_path);
+}
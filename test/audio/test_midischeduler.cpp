@@ -0,0 +1,153 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <audio/midischeduler.h>
+#include <vector>
+
+using Clock = MidiScheduler::Clock;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+namespace
+{
+/// A clock that only advances when the scheduler waits, or when time is
+/// spent elsewhere (e.g. sending a message). Sleeping overshoots the target
+/// time, as a real sleep often does.
+class FakeClock : public MidiClock
+{
+public:
+    Clock::time_point now() const override
+    {
+        return myTime;
+    }
+
+    void sleepUntil(Clock::time_point time) override
+    {
+        mySleepTargets.push_back(time);
+        myTime = std::max(myTime, time) + OVERSLEEP;
+    }
+
+    void yield() override
+    {
+        myTime += YIELD_DURATION;
+    }
+
+    void advance(Clock::duration duration)
+    {
+        myTime += duration;
+    }
+
+    static constexpr microseconds OVERSLEEP{ 300 };
+    static constexpr microseconds YIELD_DURATION{ 10 };
+
+    Clock::time_point myTime;
+    std::vector<Clock::time_point> mySleepTargets;
+};
+
+/// Stands in for a MidiOutputDevice, and records when each message is sent.
+/// Sending occasionally takes longer than the interval between events, to
+/// check that the delay doesn't carry over to later events.
+struct FakeMidiOutputDevice
+{
+    explicit FakeMidiOutputDevice(FakeClock &clock) : myClock(clock)
+    {
+    }
+
+    void sendMessage()
+    {
+        mySendTimes.push_back(myClock.now());
+        if (mySendTimes.size() % 10 == 0)
+            myClock.advance(SLOW_SEND_DURATION);
+    }
+
+    static constexpr milliseconds SLOW_SEND_DURATION{ 60 };
+
+    FakeClock &myClock;
+    std::vector<Clock::time_point> mySendTimes;
+};
+} // namespace
+
+TEST_CASE("Audio/MidiScheduler/Deadlines")
+{
+    FakeClock clock;
+    MidiScheduler scheduler(480, clock);
+    clock.advance(std::chrono::seconds(1));
+    const Clock::time_point start = clock.now();
+    scheduler.start();
+
+    // A quarter note at 120bpm lasts for 500ms, or 250ms at double speed.
+    REQUIRE(scheduler.advance(480, Midi::BEAT_DURATION_120_BPM, 100) ==
+            start + milliseconds(500));
+    REQUIRE(scheduler.advance(480, Midi::BEAT_DURATION_120_BPM, 200) ==
+            start + milliseconds(750));
+    REQUIRE(scheduler.advance(0, Midi::BEAT_DURATION_120_BPM, 100) ==
+            start + milliseconds(750));
+
+    // Fractional durations should not accumulate rounding errors.
+    for (int i = 0; i < 480; ++i)
+        scheduler.advance(1, Midi::Tempo(1), 100);
+    REQUIRE(scheduler.advance(0, Midi::Tempo(1), 100) ==
+            start + milliseconds(750) + microseconds(1));
+}
+
+TEST_CASE("Audio/MidiScheduler/Wait")
+{
+    FakeClock clock;
+    FakeMidiOutputDevice device(clock);
+    MidiScheduler scheduler(480, clock);
+    const Clock::time_point start = clock.now();
+
+    // Send 60 events, 25ms apart.
+    const milliseconds interval(25);
+    std::vector<Clock::time_point> deadlines;
+    for (int i = 0; i < 60; ++i)
+    {
+        deadlines.push_back(
+            scheduler.waitForEvent(48, Midi::BEAT_DURATION_120_BPM, 200));
+        device.sendMessage();
+    }
+
+    REQUIRE(device.mySendTimes.size() == deadlines.size());
+    std::vector<Clock::time_point> expected_sleeps;
+    for (size_t i = 0; i < deadlines.size(); ++i)
+    {
+        // The deadlines are measured from the start, regardless of how late
+        // the previous events were sent.
+        REQUIRE(deadlines[i] == start + interval * static_cast<int>(i + 1));
+
+        // Events are never sent early, and the spinning makes up for
+        // oversleeping.
+        const Clock::duration lateness = device.mySendTimes[i] - deadlines[i];
+        REQUIRE(lateness >= Clock::duration::zero());
+
+        // After a slow send, the next two events are already late and are
+        // sent immediately. Otherwise, the scheduler sleeps until shortly
+        // before the deadline and then spins.
+        if (i >= 10 && i % 10 < 2)
+        {
+            REQUIRE(lateness > Clock::duration::zero());
+            continue;
+        }
+
+        REQUIRE(lateness < FakeClock::YIELD_DURATION);
+        expected_sleeps.push_back(deadlines[i] - MidiScheduler::SPIN_DURATION);
+    }
+
+    REQUIRE(clock.mySleepTargets == expected_sleeps);
+}
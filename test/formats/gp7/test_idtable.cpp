@@ -0,0 +1,114 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <formats/gp7/document.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// Returns the ids in the order they are visited by the table's iterator.
+static std::vector<int>
+getIds(const Gp7::IdTable<std::string> &table)
+{
+    std::vector<int> ids;
+    for (auto [id, item] : table)
+        ids.push_back(id);
+    return ids;
+}
+
+TEST_CASE("Formats/Gp7/IdTable/Insert")
+{
+    Gp7::IdTable<std::string> table;
+    REQUIRE(table.emplace(0, "a"));
+    REQUIRE(table.emplace(2, "b"));
+    REQUIRE(table.size() == 2);
+
+    // Duplicate ids are rejected, for both the array and the map.
+    REQUIRE(!table.emplace(2, "c"));
+    REQUIRE(table.emplace(-5, "d"));
+    REQUIRE(!table.emplace(-5, "e"));
+    REQUIRE(table.emplace(1000000, "f"));
+    REQUIRE(!table.emplace(1000000, "g"));
+    REQUIRE(table.size() == 4);
+
+    REQUIRE(table.at(0) == "a");
+    REQUIRE(table.at(2) == "b");
+    REQUIRE(table.at(-5) == "d");
+    REQUIRE(table.at(1000000) == "f");
+
+    // Missing ids, both inside and outside the array.
+    REQUIRE_THROWS_AS(table.at(1), std::out_of_range);
+    REQUIRE_THROWS_AS(table.at(3), std::out_of_range);
+    REQUIRE_THROWS_AS(table.at(-1), std::out_of_range);
+    REQUIRE_THROWS_AS(table.at(999999), std::out_of_range);
+}
+
+TEST_CASE("Formats/Gp7/IdTable/Grow")
+{
+    Gp7::IdTable<std::string> table;
+
+    // Large ids are stored in the map until the array grows to include them.
+    REQUIRE(table.emplace(5000, "large"));
+    REQUIRE(table.emplace(3000, "medium"));
+    REQUIRE(table.emplace(-1, "negative"));
+    for (int i = 0; i < 3000; i += 2)
+        REQUIRE(table.emplace(i, std::to_string(i)));
+
+    REQUIRE(table.at(3000) == "medium");
+    REQUIRE(table.at(5000) == "large");
+    REQUIRE(!table.emplace(3000, "duplicate"));
+
+    for (int i = 1; i < 3000; i += 2)
+        REQUIRE(table.emplace(i, std::to_string(i)));
+
+    // Growing the array past 3000 should move that item out of the map.
+    REQUIRE(table.emplace(3001, "3001"));
+
+    REQUIRE(table.size() == 3004);
+    REQUIRE(table.at(3000) == "medium");
+    REQUIRE(table.at(5000) == "large");
+    REQUIRE(table.at(2999) == "2999");
+    REQUIRE(!table.emplace(5000, "duplicate"));
+
+    // Iteration visits the ids in sorted order, with the negative ids first.
+    std::vector<int> expected_ids = { -1 };
+    for (int i = 0; i <= 3001; ++i)
+        expected_ids.push_back(i);
+    expected_ids.push_back(5000);
+    REQUIRE(getIds(table) == expected_ids);
+}
+
+TEST_CASE("Formats/Gp7/IdTable/Iterate")
+{
+    Gp7::IdTable<std::string> table;
+    REQUIRE(getIds(table).empty());
+
+    REQUIRE(table.emplace(7, "a"));
+    REQUIRE(table.emplace(-3, "b"));
+    REQUIRE(table.emplace(100000, "c"));
+    REQUIRE(table.emplace(-10, "d"));
+    REQUIRE(table.emplace(2, "e"));
+
+    REQUIRE(getIds(table) == std::vector<int>{ -10, -3, 2, 7, 100000 });
+
+    std::vector<std::string> items;
+    for (auto [id, item] : table)
+        items.push_back(item);
+    REQUIRE(items == std::vector<std::string>{ "d", "b", "e", "a", "c" });
+}
@@ -0,0 +1,55 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <formats/gpx/bitstream.h>
+#include <sstream>
+
+TEST_CASE("Formats/GpxImport/BitStream")
+{
+    // Use enough bytes that both the 8-byte refill and the byte-by-byte
+    // refill near the end of the input are used.
+    std::string data = "\x78\x56\x34\x12\xa5\x0f\xf0\x81";
+    data += std::string(12, '\xcc');
+    std::istringstream stream(data);
+    Gpx::BitStream input(stream);
+
+    REQUIRE(input.readInt() == 0x12345678u);
+    REQUIRE(input.getLocation() == 4);
+
+    // 0xa5 = 10100101
+    REQUIRE(input.readBit());
+    REQUIRE(!input.readBit());
+    REQUIRE(input.readBits(3) == 0b100);
+    REQUIRE(input.readBits(3, Gpx::BitStream::Reversed) == 0b101);
+    REQUIRE(input.getLocation() == 5);
+
+    // Read across byte boundaries (0x0ff081 = 0000 1111 1111 0000 1000 0001).
+    REQUIRE(input.readBits(12) == 0x0ff);
+    REQUIRE(input.readBits(12, Gpx::BitStream::Reversed) == 0x810);
+    REQUIRE(input.readBits(0) == 0);
+
+    for (int i = 0; i < 12; ++i)
+        REQUIRE(input.readBits(8) == 0xcc);
+    REQUIRE(input.isAtEnd());
+    REQUIRE(input.getLocation() == data.size());
+
+    // Reading past the end produces zeros without advancing.
+    REQUIRE(input.readBits(16) == 0);
+    REQUIRE(input.getLocation() == data.size());
+}
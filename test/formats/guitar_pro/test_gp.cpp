@@ -18,7 +18,11 @@
 #include <doctest/doctest.h>
 
 #include <app/paths.h>
+#include <formats/fileformat.h>
+#include <formats/guitar_pro/document.h>
 #include <formats/guitar_pro/guitarproimporter.h>
+#include <formats/guitar_pro/inputstream.h>
+#include <fstream>
 #include <score/score.h>
 
 static void loadTest(GuitarProImporter &importer, const char *filename,
@@ -548,3 +552,28 @@ TEST_CASE("Formats/GuitarPro/TremoloBars")
         REQUIRE(pos.getTremoloBar().getPitch() == 6);
     }
 }
+
+TEST_CASE("Formats/GuitarPro/TruncatedFile")
+{
+    std::ifstream in(Paths::getAppDirPath("data/notes.gp5"),
+                     std::ios::binary | std::ios::in);
+    std::vector<std::byte> bytes;
+    for (char c; in.get(c);)
+        bytes.push_back(static_cast<std::byte>(c));
+
+    const std::span<const std::byte> data(bytes);
+    {
+        Gp::InputStream stream(data);
+        Gp::Document document;
+        REQUIRE_NOTHROW(document.load(stream));
+    }
+
+    {
+        Gp::InputStream stream(data.first(data.size() / 2));
+        Gp::Document document;
+        REQUIRE_THROWS_AS(document.load(stream), FileFormatException);
+    }
+
+    // Incomplete header.
+    REQUIRE_THROWS_AS(Gp::InputStream(data.first(10)), FileFormatException);
+}
@@ -0,0 +1,176 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <app/paths.h>
+#include <formats/powertab/powertabbinaryexporter.h>
+#include <formats/powertab/powertabbinaryimporter.h>
+#include <formats/powertab/powertabimporter.h>
+#include <formats/powertab_old/powertaboldimporter.h>
+#include <score/binaryserialization.h>
+#include <score/score.h>
+#include <score/serialization.h>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+template <typename FirstT, typename SecondT>
+struct EnumPair
+{
+    template <class Archive>
+    void serialize(Archive &ar, const FileVersion /*version*/)
+    {
+        ar("first", myFirst);
+        ar("second", mySecond);
+    }
+
+    FirstT myFirst = {};
+    SecondT mySecond = {};
+};
+} // namespace
+
+TEST_CASE("Formats/PowerTabBinary/RoundTrip")
+{
+    // Verify that every .pt2 and .ptb test file produces an identical score
+    // after a round trip through the binary format.
+    for (auto &&entry :
+         std::filesystem::directory_iterator(Paths::getAppDirPath("data")))
+    {
+        const std::filesystem::path &test_file = entry.path();
+        CAPTURE(test_file);
+
+        Score score1;
+        if (test_file.extension() == ".pt2")
+            PowerTabImporter().load(test_file, score1);
+        else if (test_file.extension() == ".ptb")
+            PowerTabOldImporter().load(test_file, score1);
+        else
+            continue;
+
+        std::filesystem::path temp_file =
+            Paths::getAppDirPath("data/__generated.pt2b");
+        PowerTabBinaryExporter().save(temp_file, score1);
+
+        Score score2;
+        PowerTabBinaryImporter().load(temp_file, score2);
+
+        REQUIRE(score1 == score2);
+
+        std::ostringstream output1;
+        ScoreUtils::save(output1, "score", score1);
+
+        std::ostringstream output2;
+        ScoreUtils::save(output2, "score", score2);
+
+        REQUIRE(output1.str() == output2.str());
+    }
+}
+
+TEST_CASE("Formats/PowerTabBinary/InvalidData")
+{
+    Score score;
+    PowerTabOldImporter().load(Paths::getAppDirPath("data/guitar_ins.ptb"),
+                               score);
+
+    std::ostringstream output;
+    ScoreUtils::saveBinary(output, score);
+    const std::string data = output.str();
+
+    // Truncated data.
+    {
+        Score copy;
+        std::istringstream input(data.substr(0, data.size() / 2));
+        REQUIRE_THROWS(ScoreUtils::loadBinary(input, copy));
+    }
+
+    // Missing header.
+    {
+        Score copy;
+        std::istringstream input(data.substr(4));
+        REQUIRE_THROWS(ScoreUtils::loadBinary(input, copy));
+    }
+
+    // Corrupt bytes must either load or be rejected, but never produce
+    // invalid values (e.g. for enums).
+    for (size_t i = 4; i < data.size(); ++i)
+    {
+        std::string corrupt_data = data;
+        corrupt_data[i] = static_cast<char>(~corrupt_data[i]);
+
+        Score copy;
+        std::istringstream input(corrupt_data);
+        try
+        {
+            ScoreUtils::loadBinary(input, copy);
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+
+    // An invalid file should be reported as a file format error.
+    {
+        const auto temp_file = Paths::getAppDirPath("data/__generated.pt2b");
+        {
+            std::ofstream file(temp_file, std::ios::out | std::ios::binary);
+            file << data.substr(0, data.size() / 2);
+        }
+
+        Score copy;
+        REQUIRE_THROWS_AS(PowerTabBinaryImporter().load(temp_file, copy),
+                          FileFormatException);
+        std::filesystem::remove(temp_file);
+    }
+}
+
+TEST_CASE("Formats/PowerTabBinary/EnumTags")
+{
+    using Clef = Staff::ClefType;
+    using Duration = Position::DurationType;
+
+    // The second value refers to the tag that was defined for the first value.
+    const EnumPair<Clef, Clef> clefs{ Staff::BassClef, Staff::BassClef };
+    std::ostringstream output;
+    ScoreUtils::saveBinary(output, clefs);
+    const std::string data = output.str();
+
+    {
+        EnumPair<Clef, Clef> pair;
+        std::istringstream input(data);
+        ScoreUtils::loadBinary(input, pair);
+        REQUIRE(pair.mySecond == Staff::BassClef);
+    }
+
+    // A tag cannot be used for a different enum type.
+    {
+        EnumPair<Clef, Duration> pair;
+        std::istringstream input(data);
+        REQUIRE_THROWS(ScoreUtils::loadBinary(input, pair));
+    }
+}
+
+TEST_CASE("Formats/PowerTabBinary/WriteError")
+{
+    // A file that can't be written should be reported as an error rather than
+    // silently producing nothing.
+    const std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                       "pte_missing_dir" / "score.pt2b";
+    REQUIRE_THROWS_AS(PowerTabBinaryExporter().save(path, Score()),
+                      FileFormatException);
+}
@@ -21,6 +21,7 @@
 #include <formats/powertab/powertabimporter.h>
 #include <formats/powertab_old/powertaboldimporter.h>
 #include <formats/powertab_old/powertabdocument/powertabdocument.h>
+#include <fstream>
 #include <score/score.h>
 #include <util/tostring.h>
 
@@ -423,3 +424,26 @@ TEST_CASE("Formats/PowerTabOldImport/ChordDiagrams")
     REQUIRE(Util::toString(score.getChordDiagrams()[0]) == "A: 5 7 7 6 5 5 (5)");
     REQUIRE(Util::toString(score.getChordDiagrams()[1]) == "Asus2: x 0 2 2 0 0");
 }
+
+TEST_CASE("Formats/PowerTabOldImport/TruncatedFile")
+{
+    std::string data;
+    {
+        std::ifstream in(Paths::getAppDirPath("data/guitar_ins.ptb"),
+                         std::ios::binary | std::ios::in);
+        data.assign(std::istreambuf_iterator<char>(in), {});
+    }
+
+    // Use an extension that won't be picked up by tests that load every .ptb
+    // file.
+    const std::filesystem::path temp_file =
+        Paths::getAppDirPath("data/__generated.tmp");
+    {
+        std::ofstream out(temp_file, std::ios::binary | std::ios::out);
+        out.write(data.data(), data.size() / 2);
+    }
+
+    Score score;
+    PowerTabOldImporter importer;
+    REQUIRE_THROWS_AS(importer.load(temp_file, score), FileFormatException);
+}
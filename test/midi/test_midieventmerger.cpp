@@ -0,0 +1,64 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <midi/midieventmerger.h>
+
+TEST_CASE("Midi/MidiEventMerger/Empty")
+{
+    std::vector<MidiEventList> tracks(3);
+    MidiEventMerger merger(tracks);
+    REQUIRE(!merger.next());
+}
+
+TEST_CASE("Midi/MidiEventMerger/MatchesStableSort")
+{
+    std::vector<MidiEventList> tracks(3);
+    for (int i = 0; i < 50; ++i)
+    {
+        const SystemLocation location(0, i);
+        tracks[0].append(MidiEvent::noteOn(i * 10, 0, 40, 127, location));
+        tracks[1].append(MidiEvent::noteOn(i * 15, 1, 50, 127, location));
+        tracks[1].append(MidiEvent::noteOff(i * 15 + 5, 1, 50, location));
+        tracks[2].append(MidiEvent::noteOn(i * 30, 2, 60, 127, location));
+    }
+
+    // Build the expected results by sorting the combined list of events.
+    MidiEventList expected;
+    for (const MidiEventList &track : tracks)
+        expected.concat(track);
+    std::stable_sort(expected.begin(), expected.end());
+    expected.convertToDeltaTicks();
+
+    for (MidiEventList &track : tracks)
+        track.convertToDeltaTicks();
+
+    MidiEventMerger merger(tracks);
+    for (const MidiEvent &expected_event : expected)
+    {
+        std::optional<MidiEvent> event = merger.next();
+        REQUIRE(event);
+        REQUIRE(event->getTicks() == expected_event.getTicks());
+        REQUIRE(event->getChannel() == expected_event.getChannel());
+        REQUIRE(event->getLocation() == expected_event.getLocation());
+        REQUIRE(std::ranges::equal(event->getData(), expected_event.getData()));
+    }
+
+    REQUIRE(!merger.next());
+}
@@ -0,0 +1,86 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <app/paths.h>
+#include <formats/powertab_old/powertaboldimporter.h>
+#include <midi/midieventmerger.h>
+#include <midi/midieventstream.h>
+#include <midi/midifile.h>
+#include <score/score.h>
+
+static MidiFile::LoadOptions getOptions()
+{
+    MidiFile::LoadOptions options;
+    options.myEnableMetronome = true;
+    options.myRecordPositionChanges = true;
+    return options;
+}
+
+static void loadScore(const char *filename, Score &score)
+{
+    PowerTabOldImporter importer;
+    importer.load(Paths::getAppDirPath(filename), score);
+}
+
+TEST_CASE("Midi/MidiEventStream/MatchesLoad")
+{
+    // Include files with tempo changes and grace notes, which produce events
+    // outside of the current bar.
+    for (const char *filename :
+         { "data/tempo_markers.ptb", "data/notes.ptb", "data/bends.ptb",
+           "data/alternate_endings.ptb" })
+    {
+        Score score;
+        loadScore(filename, score);
+
+        MidiFile file;
+        file.load(score, getOptions());
+        MidiEventMerger expected(file.getTracks());
+
+        MidiEventStream stream(score, getOptions());
+        REQUIRE(stream.getTicksPerBeat() == file.getTicksPerBeat());
+
+        int num_events = 0;
+        while (std::optional<MidiEvent> event = stream.next())
+        {
+            std::optional<MidiEvent> expected_event = expected.next();
+            REQUIRE(expected_event);
+            REQUIRE(event->getTicks() == expected_event->getTicks());
+            REQUIRE(std::ranges::equal(event->getData(),
+                                       expected_event->getData()));
+            REQUIRE(event->getLocation() == expected_event->getLocation());
+            ++num_events;
+        }
+
+        REQUIRE(!expected.next());
+        REQUIRE(num_events > 0);
+    }
+}
+
+TEST_CASE("Midi/MidiEventStream/StopEarly")
+{
+    Score score;
+    loadScore("data/tempo_markers.ptb", score);
+
+    // Destroying the stream should stop the generator, even if it is waiting
+    // for space in the queue.
+    MidiEventStream stream(score, getOptions());
+    REQUIRE(stream.next());
+}
@@ -0,0 +1,127 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <app/paths.h>
+#include <formats/powertab_old/powertaboldimporter.h>
+#include <midi/midibarcache.h>
+#include <midi/midifile.h>
+#include <score/score.h>
+
+static MidiFile::LoadOptions getOptions()
+{
+    MidiFile::LoadOptions options;
+    options.myEnableMetronome = true;
+    options.myRecordPositionChanges = true;
+    return options;
+}
+
+static void checkEqual(const MidiFile &expected, const MidiFile &actual)
+{
+    REQUIRE(actual.getTracks().size() == expected.getTracks().size());
+
+    for (size_t i = 0; i < expected.getTracks().size(); ++i)
+    {
+        const MidiEventList &expected_track = expected.getTracks()[i];
+        const MidiEventList &actual_track = actual.getTracks()[i];
+        REQUIRE(actual_track.size() == expected_track.size());
+
+        auto expected_it = expected_track.begin();
+        for (const MidiEvent &event : actual_track)
+        {
+            REQUIRE(event.getTicks() == expected_it->getTicks());
+            REQUIRE(std::ranges::equal(event.getData(),
+                                       expected_it->getData()));
+            ++expected_it;
+        }
+    }
+}
+
+TEST_CASE("Midi/MidiFile/BarCache")
+{
+    Score score;
+    PowerTabOldImporter importer;
+    importer.load(Paths::getAppDirPath("data/tempo_markers.ptb"), score);
+
+    MidiBarCache cache;
+    MidiFile expected;
+    expected.load(score, getOptions());
+
+    SUBCASE("Unmodified")
+    {
+        MidiFile first, second;
+        first.load(score, getOptions(), &cache);
+        second.load(score, getOptions(), &cache);
+
+        checkEqual(expected, first);
+        checkEqual(expected, second);
+    }
+
+    SUBCASE("Modified")
+    {
+        MidiFile first;
+        first.load(score, getOptions(), &cache);
+
+        // Remove a note and check that the bar is regenerated.
+        Voice &voice = score.getSystems()[0].getStaves()[0].getVoices()[0];
+        REQUIRE(!voice.getPositions().empty());
+        voice.removePosition(voice.getPositions().front());
+        cache.invalidateSystem(0);
+
+        MidiFile modified, modified_expected;
+        modified.load(score, getOptions(), &cache);
+        modified_expected.load(score, getOptions());
+        checkEqual(modified_expected, modified);
+    }
+
+    SUBCASE("Stale")
+    {
+        // Bars generated from a copy of the score that was taken before an
+        // edit should not be cached.
+        const Score copy(score);
+        const uint64_t generation = cache.setOptions(getOptions());
+
+        Voice &voice = score.getSystems()[0].getStaves()[0].getVoices()[0];
+        REQUIRE(!voice.getPositions().empty());
+        voice.removePosition(voice.getPositions().front());
+        cache.invalidateSystem(0);
+
+        MidiFile stale;
+        stale.generate(copy, getOptions(), &cache, generation,
+                       [](std::vector<MidiEventList> &, int) { return true; });
+
+        MidiFile modified, modified_expected;
+        modified.load(score, getOptions(), &cache);
+        modified_expected.load(score, getOptions());
+        checkEqual(modified_expected, modified);
+    }
+
+    SUBCASE("Options Changed")
+    {
+        MidiFile first;
+        first.load(score, getOptions(), &cache);
+
+        MidiFile::LoadOptions options = getOptions();
+        options.myMetronomePreset = 40;
+        MidiFile second, second_expected;
+        second.load(score, options, &cache);
+        second_expected.load(score, options);
+        checkEqual(second_expected, second);
+    }
+}
@@ -0,0 +1,116 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <painters/layoutcache.h>
+#include <score/score.h>
+#include <score/scorelocation.h>
+#include <utility>
+
+static Score createScore()
+{
+    Position pos(1);
+    pos.setProperty(Position::PalmMuting);
+    pos.insertNote(Note(2, 3));
+
+    Staff staff(6);
+    staff.getVoices()[0].insertPosition(pos);
+
+    System system;
+    system.insertStaff(staff);
+
+    Score score;
+    score.insertSystem(system);
+    return score;
+}
+
+TEST_CASE("Painters/LayoutCache/Reuse")
+{
+    Score score = createScore();
+    const ConstScoreLocation location(score);
+    LayoutCache cache;
+
+    LayoutConstPtr layout = cache.getLayout(location);
+    REQUIRE(cache.getLayout(location) == layout);
+
+    cache.invalidateSystem(0);
+    REQUIRE(cache.getLayout(location) != layout);
+}
+
+TEST_CASE("Painters/LayoutCache/SharedSystemData")
+{
+    Score score = createScore();
+    const ConstScoreLocation location(score);
+    LayoutCache cache;
+
+    // Build the layout while the system's data is shared with a copy of the
+    // score (e.g. an undo snapshot or the score being played back).
+    auto copy = std::make_unique<Score>(score);
+    LayoutConstPtr layout = cache.getLayout(location);
+    REQUIRE(layout->getTabStaffAboveSymbols().size() == 1);
+
+    // Accessing the system through a non-const accessor gives it a private
+    // copy of its data, and dropping the copy of the score then frees the data
+    // that the cached layout refers to.
+    score.getSystems()[0].getBarlines();
+    copy.reset();
+    layout.reset();
+
+    // The cached layout must not be reused.
+    layout = cache.getLayout(location);
+    const Voice &voice =
+        std::as_const(score).getSystems()[0].getStaves()[0].getVoices()[0];
+
+    REQUIRE(layout->getTabStaffAboveSymbols().size() == 1);
+    const SymbolGroup &group = layout->getTabStaffAboveSymbols()[0];
+    REQUIRE(&group.getVoice() == &voice);
+    REQUIRE(group.getVoice().getPositions().size() == 1);
+}
+
+TEST_CASE("Painters/LayoutCache/StaffGeometry")
+{
+    Score score = createScore();
+    const ConstScoreLocation location(score);
+    LayoutCache cache;
+
+    LayoutConstPtr layout = cache.getLayout(location);
+    const StaffGeometry geometry(*layout);
+
+    REQUIRE(geometry.getStringCount() == layout->getStringCount());
+    REQUIRE(geometry.getTabLineSpacing() == layout->getTabLineSpacing());
+    REQUIRE(geometry.getTopStdNotationLine() ==
+            layout->getTopStdNotationLine());
+    REQUIRE(geometry.getBottomStdNotationLine() ==
+            layout->getBottomStdNotationLine());
+    REQUIRE(geometry.getTopTabLine() == layout->getTopTabLine());
+    REQUIRE(geometry.getBottomTabLine() ==
+            doctest::Approx(layout->getBottomTabLine()));
+
+    for (int i = 1; i <= LayoutInfo::NUM_STD_NOTATION_LINES; ++i)
+    {
+        REQUIRE(geometry.getStdNotationLine(i) ==
+                layout->getStdNotationLine(i));
+    }
+
+    for (int i = 1; i <= layout->getStringCount(); ++i)
+    {
+        REQUIRE(geometry.getTabLine(i) ==
+                doctest::Approx(layout->getTabLine(i)));
+    }
+}
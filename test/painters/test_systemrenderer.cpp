@@ -0,0 +1,119 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <app/paths.h>
+#include <app/viewoptions.h>
+#include <filesystem>
+#include <formats/powertab/powertabimporter.h>
+#include <formats/powertab_old/powertaboldimporter.h>
+#include <memory>
+#include <painters/layoutcache.h>
+#include <painters/scoreclickevent.h>
+#include <painters/systemrenderer.h>
+#include <QFontDatabase>
+#include <QGraphicsItem>
+#include <QPalette>
+#include <score/score.h>
+#include <typeinfo>
+#include <util/parallelfor.h>
+#include <vector>
+
+using ItemPtr = std::unique_ptr<QGraphicsItem>;
+
+/// Renders every system of the score using the given number of threads, in
+/// the same way as the score area.
+static std::vector<ItemPtr> renderSystems(const Score &score, int num_threads)
+{
+    const ViewOptions view_options;
+    const QPalette palette;
+    const ScoreClickEvent click_event;
+    LayoutCache layout_cache;
+
+    const int num_systems = static_cast<int>(score.getSystems().size());
+    std::vector<ItemPtr> systems(num_systems);
+    Util::parallelFor(
+        num_systems,
+        [&](int i) {
+            SystemRenderer render(score, view_options, layout_cache, palette,
+                                  click_event);
+            systems[i].reset(render(score.getSystems()[i], i));
+        },
+        num_threads);
+
+    return systems;
+}
+
+/// Checks that the items and their children are drawn identically.
+static void compareItems(const QGraphicsItem &item1, const QGraphicsItem &item2)
+{
+    REQUIRE(typeid(item1) == typeid(item2));
+    REQUIRE(item1.pos() == item2.pos());
+    REQUIRE(item1.boundingRect() == item2.boundingRect());
+    REQUIRE(item1.zValue() == item2.zValue());
+    REQUIRE(item1.isVisible() == item2.isVisible());
+    REQUIRE(item1.flags() == item2.flags());
+
+    const QList<QGraphicsItem *> children1 = item1.childItems();
+    const QList<QGraphicsItem *> children2 = item2.childItems();
+    REQUIRE(children1.size() == children2.size());
+
+    for (int i = 0; i < children1.size(); ++i)
+        compareItems(*children1[i], *children2[i]);
+}
+
+TEST_CASE("Painters/SystemRenderer/Parallel")
+{
+    QFontDatabase::addApplicationFont(QStringLiteral(":fonts/emmentaler-13.otf"));
+    QFontDatabase::addApplicationFont(
+        QStringLiteral(":fonts/LiberationSans-Regular.ttf"));
+    QFontDatabase::addApplicationFont(
+        QStringLiteral(":fonts/LiberationSerif-Regular.ttf"));
+
+    // Rendering the systems in parallel should produce the same items as
+    // rendering them one at a time.
+    size_t max_systems = 0;
+    for (auto &&entry :
+         std::filesystem::directory_iterator(Paths::getAppDirPath("data")))
+    {
+        const std::filesystem::path &test_file = entry.path();
+
+        Score score;
+        if (test_file.extension() == ".pt2")
+            PowerTabImporter().load(test_file, score);
+        else if (test_file.extension() == ".ptb")
+            PowerTabOldImporter().load(test_file, score);
+        else
+            continue;
+
+        CAPTURE(test_file);
+        max_systems = std::max(max_systems, score.getSystems().size());
+
+        const std::vector<ItemPtr> serial = renderSystems(score, 1);
+        const std::vector<ItemPtr> parallel = renderSystems(score, 8);
+
+        REQUIRE(serial.size() == parallel.size());
+        for (size_t i = 0; i < serial.size(); ++i)
+            compareItems(*serial[i], *parallel[i]);
+    }
+
+    // Make sure that at least one of the scores was actually split across
+    // several threads.
+    REQUIRE(max_systems > 1);
+}
@@ -0,0 +1,168 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <score/note.h>
+#include <score/player.h>
+#include <score/score.h>
+#include <score/serialization.h>
+#include <sstream>
+#include "test_serialization.h"
+
+template <typename T>
+static void loadText(const std::string &text, const char *name, T &obj)
+{
+    std::istringstream input(text);
+    ScoreUtils::load(input, name, obj);
+}
+
+TEST_CASE("Score/Serialization/Strings")
+{
+    Player player;
+    loadText(R"({
+        "version": 11,
+        "player": {
+            "description": "Tab\t\"Lead\" \/ caf\u00e9 \ud83c\udfb8"
+        }
+    })", "player", player);
+
+    REQUIRE(player.getDescription() == "Tab\t\"Lead\" / caf\xC3\xA9 \xF0\x9F\x8E\xB8");
+
+    player.setDescription(player.getDescription() + "\\ \x01\r\n");
+    Serialization::test("player", player);
+}
+
+TEST_CASE("Score/Serialization/Members")
+{
+    Player player;
+    player.setDescription("Original");
+    player.setMaxVolume(100);
+
+    // Members can be in any order or missing, and the last duplicate key is
+    // used.
+    loadText(R"({
+        "player": {
+            "tuning": { "notes": null, "offset": 2, "sharps": false },
+            "pan": 12,
+            "max_volume": 1,
+            "max_volume": 50.0
+        },
+        "version": 11
+    })", "player", player);
+
+    REQUIRE(player.getDescription() == "Original");
+    REQUIRE(player.getMaxVolume() == 50);
+    REQUIRE(player.getPan() == 12);
+    REQUIRE(player.getTuning().getStringCount() == 0);
+    REQUIRE(player.getTuning().getMusicNotationOffset() == 2);
+    REQUIRE(!player.getTuning().usesSharps());
+}
+
+TEST_CASE("Score/Serialization/OldVersion")
+{
+    // Before the JSON cleanup, flags were stored as a string of bits and
+    // missing values were stored as -1.
+    Note note;
+    loadText(R"({
+        "version": 9,
+        "note": {
+            "string": 2,
+            "fret": 5,
+            "properties": "00000000000000101",
+            "trill": -1,
+            "tapped_harmonic": 12,
+            "artificial_harmonic": null,
+            "bend": null
+        }
+    })", "note", note);
+
+    REQUIRE(note.getString() == 2);
+    REQUIRE(note.getFretNumber() == 5);
+    REQUIRE(note.hasProperty(Note::Tied));
+    REQUIRE(!note.hasProperty(Note::Muted));
+    REQUIRE(note.hasProperty(Note::HammerOnOrPullOff));
+    REQUIRE(!note.hasTrill());
+    REQUIRE(note.getTappedHarmonicFret() == 12);
+    REQUIRE(!note.hasArtificialHarmonic());
+    REQUIRE(!note.hasBend());
+}
+
+TEST_CASE("Score/Serialization/LargeScore")
+{
+    // Large arrays of objects are loaded in parallel, so check that the
+    // systems are still assembled in order.
+    Score score;
+    for (int i = 0; i < 500; ++i)
+    {
+        System system;
+        system.insertStaff(Staff(6));
+        system.insertTextItem(TextItem(i % 10, "System " + std::to_string(i)));
+        score.insertSystem(system);
+    }
+
+    Serialization::test("score", score);
+}
+
+TEST_CASE("Score/Serialization/InvalidInput")
+{
+    Player player;
+    REQUIRE_THROWS(loadText("", "player", player));
+    REQUIRE_THROWS(loadText(R"({ "version": 11, "player": { "pan": 1 })",
+                            "player", player));
+    REQUIRE_THROWS(loadText(R"({ "version": 11, "player": [ "pan" } })",
+                            "player", player));
+    REQUIRE_THROWS(loadText(R"({ "version": 11, "player": { "pan": true } })",
+                            "player", player));
+    REQUIRE_THROWS(loadText(R"({ "version": 11, "player": { "pan": 300 } })",
+                            "player", player));
+
+    // Unlike std::from_chars, JSON doesn't allow leading zeros etc.
+    REQUIRE_THROWS(loadText(R"({ "version": 11, "player": { "pan": 01 } })",
+                            "player", player));
+    REQUIRE_THROWS(loadText(R"({ "version": 11, "player": { "pan": .5 } })",
+                            "player", player));
+    REQUIRE_THROWS(loadText(R"({ "version": 11, "player": { "pan": inf } })",
+                            "player", player));
+    REQUIRE_THROWS(loadText(
+        R"({ "version": 11, "player": { "tuning": { "sharps": truex } } })",
+        "player", player));
+
+    // Only whitespace can follow the root value.
+    REQUIRE_NOTHROW(loadText("{ \"version\": 11, \"player\": {} }\n",
+                             "player", player));
+    REQUIRE_THROWS(loadText(R"({ "version": 11, "player": {} } trailing)",
+                            "player", player));
+    REQUIRE_THROWS(loadText(R"({ "version": 11, "player": {} } {})",
+                            "player", player));
+
+    // Members that are never read must still be valid JSON.
+    auto loadJunk = [&](const std::string &junk) {
+        loadText(R"({ "version": 11, "player": {}, "junk": )" + junk + " }",
+                 "player", player);
+    };
+    REQUIRE_THROWS(loadJunk("@@@"));
+    REQUIRE_THROWS(loadJunk(R"({"a" 1})"));
+    REQUIRE_THROWS(loadJunk("[1,2,]"));
+    REQUIRE_THROWS(loadJunk("[1 2]"));
+    REQUIRE_THROWS(loadJunk("{,}"));
+    REQUIRE_THROWS(loadJunk("\"a\tb\""));
+    REQUIRE_THROWS(loadJunk(R"("\x")"));
+    REQUIRE_THROWS(loadJunk(R"("\udc00")"));
+    REQUIRE_THROWS(loadJunk(R"("\ud800")"));
+    REQUIRE_NOTHROW(loadJunk(R"([{}, [], "\ud83c\udfb8", -1.5e3, null])"));
+}
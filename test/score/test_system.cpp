@@ -17,6 +17,8 @@
   
 #include <doctest/doctest.h>
 
+#include <score/score.h>
+#include <score/scorelocation.h>
 #include <score/system.h>
 
 TEST_CASE("Score/System/Staves")
@@ -203,3 +205,79 @@ TEST_CASE("Score/System/TextItems")
     REQUIRE(system.getTextItems().size() == 1);
     REQUIRE(system.getTextItems()[0] == text1);
 }
+
+TEST_CASE("Score/System/Copy")
+{
+    System system;
+    system.insertStaff(Staff(6));
+
+    // Modifying either copy should not affect the other, even though the
+    // data is shared until then.
+    System copy(system);
+    REQUIRE(copy == system);
+
+    copy.getStaves()[0].setClefType(Staff::BassClef);
+    copy.insertTextItem(TextItem(1, "foo"));
+    REQUIRE(system.getStaves()[0].getClefType() == Staff::TrebleClef);
+    REQUIRE(system.getTextItems().empty());
+    REQUIRE(copy != system);
+
+    system = copy;
+    system.removeTextItem(copy.getTextItems()[0]);
+    REQUIRE(copy.getTextItems().size() == 1);
+    REQUIRE(system.getTextItems().empty());
+}
+
+TEST_CASE("Score/System/Generation")
+{
+    System system;
+    const uint64_t generation = system.getGeneration();
+    REQUIRE(System().getGeneration() != generation);
+
+    // Modifying unshared data doesn't change the generation.
+    system.insertStaff(Staff(6));
+    REQUIRE(system.getGeneration() == generation);
+
+    // Copies share the same data until one of them is modified.
+    System copy(system);
+    REQUIRE(copy.getGeneration() == generation);
+
+    system.getStaves();
+    REQUIRE(system.getGeneration() != generation);
+    REQUIRE(copy.getGeneration() == generation);
+    REQUIRE(copy == system);
+}
+
+TEST_CASE("Score/System/WriteableLocation")
+{
+    Position pos(1);
+    pos.insertNote(Note(2, 3));
+
+    Staff staff(6);
+    staff.getVoices()[0].insertPosition(pos);
+
+    System system;
+    system.insertStaff(staff);
+
+    Score score;
+    score.insertSystem(system);
+    const Score copy(score);
+
+    // Writeable pointers from a score location must not modify data that is
+    // shared with a copy of the score.
+    ScoreLocation location(score, 0, 0, 1, 0, 2);
+    location.getPosition()->setProperty(Position::PalmMuting);
+    location.getNote()->setProperty(Note::Tied);
+    location.getSelectedNotes()[0]->setProperty(Note::Octave8va);
+
+    const Position &orig_pos =
+        copy.getSystems()[0].getStaves()[0].getVoices()[0].getPositions()[0];
+    REQUIRE(!orig_pos.hasProperty(Position::PalmMuting));
+    REQUIRE(!orig_pos.getNotes()[0].hasProperty(Note::Tied));
+    REQUIRE(!orig_pos.getNotes()[0].hasProperty(Note::Octave8va));
+
+    const ConstScoreLocation new_location(score, 0, 0, 1, 0, 2);
+    REQUIRE(new_location.getPosition()->hasProperty(Position::PalmMuting));
+    REQUIRE(new_location.getNote()->hasProperty(Note::Tied));
+    REQUIRE(new_location.getNote()->hasProperty(Note::Octave8va));
+}
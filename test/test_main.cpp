@@ -17,13 +17,20 @@
 
 #define DOCTEST_CONFIG_IMPLEMENT
 #include <doctest/doctest.h>
-#include <QCoreApplication>
+#include <QGuiApplication>
 
 int main(int argc, char *argv[])
 {
-    // Initialize QCoreApplication for any tests that use
-    // QCoreApplication::applicationDirPath().
-    QCoreApplication app(argc, argv);
+    // Use the offscreen platform so that the rendering tests can run without
+    // a display.
+#ifndef _WIN32
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+#endif
+
+    // Initialize QGuiApplication for any tests that use
+    // QCoreApplication::applicationDirPath() or render the score.
+    QGuiApplication app(argc, argv);
 
     return doctest::Context(argc, argv).run();
 }
@@ -0,0 +1,91 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <util/parallelfor.h>
+#include <vector>
+
+TEST_CASE("Util/ParallelFor/MatchesSerial")
+{
+    const int count = 1000;
+    std::vector<int> serial(count, 0);
+    std::vector<int> parallel(count, 0);
+
+    Util::parallelFor(count, [&](int i) { serial[i] = i * i; }, 1);
+    Util::parallelFor(count, [&](int i) { parallel[i] = i * i; }, 8);
+
+    REQUIRE(serial == parallel);
+}
+
+TEST_CASE("Util/ParallelFor/Empty")
+{
+    int calls = 0;
+    Util::parallelFor(0, [&](int) { ++calls; });
+    REQUIRE(calls == 0);
+}
+
+TEST_CASE("Util/ParallelFor/Exception")
+{
+    auto f = [](int i) {
+        if (i == 50)
+            throw std::runtime_error("error");
+    };
+
+    REQUIRE_THROWS_AS(Util::parallelFor(100, f, 4), std::runtime_error);
+}
+
+TEST_CASE("Util/ParallelFor/Nested")
+{
+    // A nested loop should run on the worker's own thread.
+    std::atomic<int> num_other_threads = 0;
+    Util::parallelFor(
+        8,
+        [&](int) {
+            const auto thread_id = std::this_thread::get_id();
+            Util::parallelFor(
+                8,
+                [&](int) {
+                    if (std::this_thread::get_id() != thread_id)
+                        ++num_other_threads;
+                },
+                8);
+        },
+        4);
+
+    REQUIRE(num_other_threads == 0);
+
+    // The same applies to threads that are marked as workers.
+    std::thread thread([&]() {
+        Util::ParallelWorkerScope worker_scope;
+        const auto thread_id = std::this_thread::get_id();
+        Util::parallelFor(
+            8,
+            [&](int) {
+                if (std::this_thread::get_id() != thread_id)
+                    ++num_other_threads;
+            },
+            8);
+    });
+    thread.join();
+
+    REQUIRE(num_other_threads == 0);
+}
+
@@ -0,0 +1,43 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <sstream>
+#include <util/readall.h>
+
+TEST_CASE("Util/ReadAll")
+{
+    {
+        std::istringstream input;
+        REQUIRE(Util::readAll(input).empty());
+    }
+
+    // Data that spans several chunks, including null bytes.
+    std::string data(200 * 1024, '\0');
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<char>(i % 251);
+
+    std::istringstream input(data);
+    REQUIRE(Util::readAll(input) == data);
+    REQUIRE(!input.bad());
+
+    // Only the remaining contents are read.
+    input.clear();
+    input.seekg(1000);
+    REQUIRE(Util::readAll(input) == data.substr(1000));
+}
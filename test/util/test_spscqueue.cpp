@@ -0,0 +1,115 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <thread>
+#include <util/spscqueue.h>
+
+TEST_CASE("Util/SpscQueue/NonBlocking")
+{
+    Util::SpscQueue<int> queue(3);
+
+    // The capacity is rounded up to 4.
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(queue.tryPush(int(i)));
+    REQUIRE(!queue.tryPush(4));
+
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(queue.tryPop() == i);
+    REQUIRE(!queue.tryPop());
+}
+
+TEST_CASE("Util/SpscQueue/Threads")
+{
+    Util::SpscQueue<int> queue(16);
+    const int num_items = 100000;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < num_items; ++i)
+            CHECK(queue.push(i));
+        queue.close();
+    });
+
+    int expected = 0;
+    while (std::optional<int> item = queue.pop())
+    {
+        REQUIRE(*item == expected);
+        ++expected;
+    }
+
+    producer.join();
+    REQUIRE(expected == num_items);
+}
+
+TEST_CASE("Util/SpscQueue/Close")
+{
+    Util::SpscQueue<int> queue(1);
+    REQUIRE(queue.push(1));
+
+    // The producer should stop waiting for space once the queue is closed.
+    std::thread producer([&]() { CHECK(!queue.push(2)); });
+    queue.close();
+    producer.join();
+
+    // Remaining items can still be removed.
+    REQUIRE(queue.pop() == 1);
+    REQUIRE(!queue.pop());
+}
+
+TEST_CASE("Util/SpscQueue/NonBlockingWakeup")
+{
+    Util::SpscQueue<int> queue(4);
+    const int num_items = 100000;
+
+    // A waiting producer must be woken up by a consumer that only uses
+    // tryPop(), once the queue has drained.
+    std::thread producer([&]() {
+        for (int i = 0; i < num_items; ++i)
+            CHECK(queue.push(i));
+    });
+
+    int expected = 0;
+    while (expected < num_items)
+    {
+        if (std::optional<int> item = queue.tryPop())
+        {
+            REQUIRE(*item == expected);
+            ++expected;
+        }
+        else
+            std::this_thread::yield();
+    }
+
+    producer.join();
+
+    // Similarly, a waiting consumer must be woken up by tryPush().
+    std::thread consumer([&]() {
+        for (int i = 0; i < num_items; ++i)
+            CHECK(queue.pop() == i);
+    });
+
+    for (int i = 0; i < num_items;)
+    {
+        if (queue.tryPush(int(i)))
+            ++i;
+        else
+            std::this_thread::yield();
+    }
+
+    consumer.join();
+}
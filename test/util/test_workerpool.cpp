@@ -0,0 +1,81 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <util/workerpool.h>
+#include <vector>
+
+TEST_CASE("Util/WorkerPool/Items")
+{
+    const std::filesystem::path temp_root =
+        std::filesystem::temp_directory_path() / "pte_test_workerpool";
+    const int num_items = 1000;
+
+    // Each item should be consumed exactly once, and the temporary folders
+    // should be removed afterwards.
+    std::vector<std::atomic<int>> counts(num_items);
+    Util::runWorkerPool<int>(
+        4, temp_root,
+        [&](Util::WorkQueue<int> &queue) {
+            for (int i = 0; i < num_items; ++i)
+                queue.push(i);
+        },
+        [&](Util::WorkQueue<int> &queue,
+            const std::filesystem::path &temp_dir) {
+            std::filesystem::create_directories(temp_dir);
+            while (std::optional<int> item = queue.pop())
+            {
+                std::ofstream(temp_dir / std::to_string(*item));
+                ++counts[*item];
+            }
+        });
+
+    for (const std::atomic<int> &count : counts)
+        REQUIRE(count == 1);
+
+    REQUIRE(!std::filesystem::exists(temp_root));
+}
+
+TEST_CASE("Util/WorkerPool/ProducerException")
+{
+    const std::filesystem::path temp_root =
+        std::filesystem::temp_directory_path() / "pte_test_workerpool";
+
+    // The queued items should still be processed.
+    std::atomic<int> num_processed = 0;
+    REQUIRE_THROWS_AS(Util::runWorkerPool<int>(
+                          2, temp_root,
+                          [&](Util::WorkQueue<int> &queue) {
+                              for (int i = 0; i < 10; ++i)
+                                  queue.push(i);
+                              throw std::runtime_error("error");
+                          },
+                          [&](Util::WorkQueue<int> &queue,
+                              const std::filesystem::path &) {
+                              while (queue.pop())
+                                  ++num_processed;
+                          }),
+                      std::runtime_error);
+
+    REQUIRE(num_processed == 10);
+}
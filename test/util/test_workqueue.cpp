@@ -0,0 +1,65 @@
+/*
+  * Copyright (C) 2026 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <thread>
+#include <util/workqueue.h>
+#include <vector>
+
+TEST_CASE("Util/WorkQueue/Threads")
+{
+    Util::WorkQueue<int> queue(4);
+    const int num_items = 10000;
+
+    // Each item should be consumed exactly once.
+    std::vector<std::atomic<int>> counts(num_items);
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 4; ++i)
+    {
+        consumers.emplace_back([&]() {
+            while (std::optional<int> item = queue.pop())
+                ++counts[*item];
+        });
+    }
+
+    for (int i = 0; i < num_items; ++i)
+        REQUIRE(queue.push(i));
+    queue.close();
+
+    for (std::thread &consumer : consumers)
+        consumer.join();
+
+    for (const std::atomic<int> &count : counts)
+        REQUIRE(count == 1);
+}
+
+TEST_CASE("Util/WorkQueue/Close")
+{
+    Util::WorkQueue<int> queue(1);
+    REQUIRE(queue.push(1));
+
+    // The producer should stop waiting for space once the queue is closed.
+    std::thread producer([&]() { CHECK(!queue.push(2)); });
+    queue.close();
+    producer.join();
+
+    // Remaining items can still be removed.
+    REQUIRE(queue.pop() == 1);
+    REQUIRE(!queue.pop());
+}